@@ -0,0 +1,31 @@
+/* compact_fib_heap.c behind the BenchHeapOps interface. Handles are
+   indices, so they are passed around as (index + 1) cast to a pointer. */
+#include <stdint.h>
+
+#include "compact_fib_heap.h"
+#include "bench_impl.h"
+
+#define TO_PTR(h) ((void*)((uintptr_t)(h) + 1))
+#define TO_HANDLE(p) ((CompactHandle)((uintptr_t)(p) - 1))
+
+static void* b_create(void) { return make_compact_fib_heap(); }
+static void* b_insert(void *H, int key) { return TO_PTR(compact_fib_heap_insert((CompactFibHeap*)H, key)); }
+
+static void* b_extract_min(void *H) {
+    CompactHandle x = compact_fib_heap_extract_min((CompactFibHeap*)H);
+    return x == COMPACT_NIL ? NULL : TO_PTR(x);
+}
+
+static void b_decrease_key(void *H, void *x, int k) {
+    compact_fib_heap_decrease_key((CompactFibHeap*)H, TO_HANDLE(x), k);
+}
+
+static int b_key_of(void *H, void *x) { return compact_fib_heap_key((CompactFibHeap*)H, TO_HANDLE(x)); }
+static int b_size(void *H) { return ((CompactFibHeap*)H)->n; }
+static void b_release(void *H, void *x) { compact_fib_heap_release((CompactFibHeap*)H, TO_HANDLE(x)); }
+static void b_destroy(void *H) { compact_fib_heap_free((CompactFibHeap*)H); }
+
+const BenchHeapOps bench_compact_ops = {
+    "compact", b_create, b_insert, b_extract_min, b_decrease_key,
+    b_key_of, b_size, b_release, b_destroy
+};
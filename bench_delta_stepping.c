@@ -0,0 +1,118 @@
+/* ============================
+   DELTA-STEPPING SCALING BENCHMARK
+   ============================
+   Runs delta_stepping() on 1, 2, 4, ... threads against sequential
+   dijkstra() on the same graph and checks that every distance matches.
+
+     gcc -O2 -pthread -DFIB_HEAP_NO_MAIN bench_delta_stepping.c delta_stepping.c \
+         dijkstra.c graph.c pq_backend.c modified_fib_heap.c pairing_heap.c \
+         dary_heap.c radix_heap.c -lm -o bench_ds
+
+   Usage: ./bench_ds [n] [max_threads] [delta] [grid|random]
+   grid is a sqrt(n) x sqrt(n) road-like lattice, random has 8 edges per
+   vertex. delta 0 lets delta_stepping choose.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "delta_stepping.h"
+
+static unsigned long long rng_state = 88172645463325252ULL;
+
+static unsigned int next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (unsigned int)(rng_state >> 11);
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static Graph* build(int n, int grid) {
+    int side = 1;
+    while ((side + 1) * (side + 1) <= n)
+        side++;
+    if (grid)
+        n = side * side;
+
+    int m = grid ? 4 * n : 8 * n;
+    int *src = (int*)malloc(m * sizeof(int));
+    int *dst = (int*)malloc(m * sizeof(int));
+    int *w = (int*)malloc(m * sizeof(int));
+    int k = 0;
+
+    for (int u = 0; u < n; u++) {
+        if (grid) {
+            int r = u / side, c = u % side;
+            int nb[4] = { r > 0 ? u - side : -1, r + 1 < side ? u + side : -1,
+                          c > 0 ? u - 1 : -1, c + 1 < side ? u + 1 : -1 };
+            for (int i = 0; i < 4; i++) {
+                if (nb[i] < 0) continue;
+                src[k] = u;
+                dst[k] = nb[i];
+                w[k] = 1 + next_rand() % 100;
+                k++;
+            }
+        } else {
+            for (int i = 0; i < 8; i++) {
+                src[k] = u;
+                dst[k] = next_rand() % n;
+                w[k] = 1 + next_rand() % 1000;
+                k++;
+            }
+        }
+    }
+
+    Graph *G = make_graph(n, k, src, dst, w);
+    free(src);
+    free(dst);
+    free(w);
+    return G;
+}
+
+int main(int argc, char **argv) {
+    int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+    int max_threads = (argc > 2) ? atoi(argv[2]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int delta = (argc > 3) ? atoi(argv[3]) : 0;
+    int grid = (argc > 4) ? strcmp(argv[4], "random") != 0 : 1;
+
+    Graph *G = build(n, grid);
+    int *ref = (int*)malloc(G->n * sizeof(int));
+    int *dist = (int*)malloc(G->n * sizeof(int));
+
+    printf("%s graph: n = %d, m = %d, delta = %d (0 = auto)\n",
+           grid ? "grid" : "random", G->n, G->m, delta);
+
+    double t0 = now_ns();
+    dijkstra(G, 0, ref, NULL);
+    double t_seq = (now_ns() - t0) / 1e6;
+    printf("%-16s %10.1f ms\n", "dijkstra", t_seq);
+
+    for (int t = 1; t <= max_threads; t *= 2) {
+        t0 = now_ns();
+        delta_stepping(G, 0, delta, t, dist, NULL);
+        double ms = (now_ns() - t0) / 1e6;
+
+        int bad = 0;
+        for (int v = 0; v < G->n; v++) {
+            if (dist[v] != ref[v])
+                bad++;
+        }
+        printf("delta %2d threads %10.1f ms  %5.2fx vs dijkstra  %s\n",
+               t, ms, t_seq / ms, bad ? "MISMATCH" : "ok");
+        if (bad)
+            return 1;
+    }
+
+    free(dist);
+    free(ref);
+    graph_free(G);
+    return 0;
+}
@@ -0,0 +1,424 @@
+/* ============================
+   HEAP BENCHMARK SUITE
+   ============================
+   Runs the same op mixes against fib_heap.c, modified_fib_heap.c, the
+   int instantiation of fib_heap_template.h and compact_fib_heap.c, and
+   reports ns/op, latency percentiles and peak RSS for each case. Every case
+   runs in a forked child, so a crash in one implementation is reported
+   instead of ending the run, and the RSS is the child's own peak.
+
+     gcc -O2 -DFIB_HEAP_NO_MAIN bench_fib_heap.c bench_original.c \
+         bench_modified.c bench_template.c bench_compact.c \
+         modified_fib_heap.c compact_fib_heap.c -lm -o bench_fib_heap
+
+   Usage: ./bench_fib_heap [-i original|modified|template|compact|all] [-w w1,w2,..]
+                           [-n 1e3,1e5 | -n 1e3:1e8] [-s seed]
+
+   Workloads:
+     insert     n inserts of random keys
+     extract    n extract_min on a heap of n random keys
+     decrease   n decrease_key on a consolidated heap of n keys
+     random     n ops: 50% insert, 30% extract_min, 20% decrease_key
+     sorted     n ascending inserts, then drain
+     reverse    n descending inserts, then drain
+     adversarial  descending runs of 64 inserts, one extract_min per run
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "bench_impl.h"
+#include "lat_hist.h"
+
+/* time one op in every LAT_SAMPLE_STRIDE for the percentiles */
+#define LAT_SAMPLE_STRIDE 8
+
+typedef struct BenchResult {
+    long long ops;
+    double ns_per_op;
+    unsigned long long p50, p90, p99, p999, max;
+} BenchResult;
+
+static unsigned long long rng_state;
+
+static unsigned int next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (unsigned int)(rng_state >> 11);
+}
+
+static unsigned long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* Run one op; every LAT_SAMPLE_STRIDE-th op is also timed on its own */
+#define TIMED_OP(i, hist, stmt)                                  \
+    do {                                                         \
+        if (((i) % LAT_SAMPLE_STRIDE) == 0) {                    \
+            unsigned long long t_ = now_ns();                    \
+            stmt;                                                \
+            lat_hist_record((hist), now_ns() - t_);              \
+        } else {                                                 \
+            stmt;                                                \
+        }                                                        \
+    } while (0)
+
+/* ============================
+   LIVE HANDLE SET
+   ============================
+   Array of live handles plus an open-addressing map from handle to its
+   slot, so the random mix can pick a live node and drop extracted ones. */
+typedef struct LiveSet {
+    void **items;
+    int *keys;
+    int count;
+    void **map_keys;
+    int *map_vals;
+    unsigned mask;
+} LiveSet;
+
+static void live_init(LiveSet *S, int cap) {
+    unsigned size = 16;
+    while (size < 2u * (unsigned)cap)
+        size <<= 1;
+
+    S->items = (void**)malloc(cap * sizeof(void*));
+    S->keys = (int*)malloc(cap * sizeof(int));
+    S->count = 0;
+    S->map_keys = (void**)calloc(size, sizeof(void*));
+    S->map_vals = (int*)malloc(size * sizeof(int));
+    S->mask = size - 1;
+}
+
+static void live_free(LiveSet *S) {
+    free(S->items);
+    free(S->keys);
+    free(S->map_keys);
+    free(S->map_vals);
+}
+
+static unsigned live_hash(const LiveSet *S, void *p) {
+    unsigned long long h = (unsigned long long)(size_t)p * 0x9E3779B97F4A7C15ULL;
+    return (unsigned)(h >> 32) & S->mask;
+}
+
+static unsigned live_find(const LiveSet *S, void *p) {
+    unsigned i = live_hash(S, p);
+    while (S->map_keys[i] != p)
+        i = (i + 1) & S->mask;
+    return i;
+}
+
+static void live_set_slot(LiveSet *S, void *p, int slot) {
+    unsigned i = live_hash(S, p);
+    while (S->map_keys[i] != NULL && S->map_keys[i] != p)
+        i = (i + 1) & S->mask;
+    S->map_keys[i] = p;
+    S->map_vals[i] = slot;
+}
+
+static void live_add(LiveSet *S, void *p, int key) {
+    S->items[S->count] = p;
+    S->keys[S->count] = key;
+    live_set_slot(S, p, S->count);
+    S->count++;
+}
+
+static void live_remove(LiveSet *S, void *p) {
+    unsigned i = live_find(S, p);
+    int slot = S->map_vals[i];
+
+    /* backward-shift deletion keeps probe chains intact */
+    unsigned j = i;
+    for (;;) {
+        j = (j + 1) & S->mask;
+        if (S->map_keys[j] == NULL)
+            break;
+        unsigned home = live_hash(S, S->map_keys[j]);
+        if (((j - home) & S->mask) >= ((j - i) & S->mask)) {
+            S->map_keys[i] = S->map_keys[j];
+            S->map_vals[i] = S->map_vals[j];
+            i = j;
+        }
+    }
+    S->map_keys[i] = NULL;
+
+    /* swap-remove from the array */
+    S->count--;
+    if (slot != S->count) {
+        S->items[slot] = S->items[S->count];
+        S->keys[slot] = S->keys[S->count];
+        live_set_slot(S, S->items[slot], slot);
+    }
+}
+
+/* ============================
+   WORKLOADS
+   ============================ */
+static const char *workloads[] = {
+    "insert", "extract", "decrease", "random", "sorted", "reverse", "adversarial"
+};
+#define NUM_WORKLOADS ((int)(sizeof(workloads) / sizeof(workloads[0])))
+
+static int random_key(void) {
+    return (int)(next_rand() % 1000000000u);
+}
+
+static long long bench_insert(const BenchHeapOps *ops, void *H, int n, LatHist *h) {
+    for (int i = 0; i < n; i++)
+        TIMED_OP(i, h, ops->insert(H, random_key()));
+    return n;
+}
+
+static long long bench_extract(const BenchHeapOps *ops, void *H, int n, LatHist *h,
+                               unsigned long long *t_start) {
+    for (int i = 0; i < n; i++)
+        ops->insert(H, random_key());
+
+    *t_start = now_ns();
+    for (int i = 0; i < n; i++)
+        TIMED_OP(i, h, ops->release(H, ops->extract_min(H)));
+    return n;
+}
+
+static long long bench_decrease(const BenchHeapOps *ops, void *H, int n, LatHist *h,
+                                unsigned long long *t_start) {
+    void **nodes = (void**)malloc(n * sizeof(void*));
+    int *keys = (int*)malloc(n * sizeof(int));
+
+    for (int i = 0; i < n; i++) {
+        keys[i] = random_key();
+        nodes[i] = ops->insert(H, keys[i]);
+    }
+
+    /* one extract consolidates the roots into trees */
+    void *m = ops->extract_min(H);
+    for (int i = 0; i < n; i++) {
+        if (nodes[i] == m) {
+            nodes[i] = nodes[n - 1];
+            keys[i] = keys[n - 1];
+            break;
+        }
+    }
+    ops->release(H, m);
+    int live = n - 1;
+
+    *t_start = now_ns();
+    for (int i = 0; i < n; i++) {
+        int j = (int)(next_rand() % (unsigned)live);
+        keys[j] -= 1 + (int)(next_rand() % 1000u);
+        TIMED_OP(i, h, ops->decrease_key(H, nodes[j], keys[j]));
+    }
+
+    free(nodes);
+    free(keys);
+    return n;
+}
+
+static long long bench_random(const BenchHeapOps *ops, void *H, int n, LatHist *h) {
+    LiveSet S;
+    live_init(&S, n);
+
+    for (int i = 0; i < n; i++) {
+        unsigned r = next_rand() % 10u;
+
+        if (r < 5 || S.count == 0) {
+            int key = random_key();
+            void *x;
+            TIMED_OP(i, h, x = ops->insert(H, key));
+            live_add(&S, x, key);
+        } else if (r < 8) {
+            void *x;
+            TIMED_OP(i, h, x = ops->extract_min(H));
+            live_remove(&S, x);
+            ops->release(H, x);
+        } else {
+            int j = (int)(next_rand() % (unsigned)S.count);
+            S.keys[j] -= 1 + (int)(next_rand() % 1000u);
+            TIMED_OP(i, h, ops->decrease_key(H, S.items[j], S.keys[j]));
+        }
+    }
+
+    live_free(&S);
+    return n;
+}
+
+/* direction > 0: ascending keys, < 0: descending */
+static long long bench_stream(const BenchHeapOps *ops, void *H, int n, LatHist *h, int direction) {
+    for (int i = 0; i < n; i++)
+        TIMED_OP(i, h, ops->insert(H, direction > 0 ? i : n - i));
+    for (int i = 0; i < n; i++)
+        TIMED_OP(i, h, ops->release(H, ops->extract_min(H)));
+    return 2LL * n;
+}
+
+static long long bench_adversarial(const BenchHeapOps *ops, void *H, int n, LatHist *h) {
+    long long done = 0;
+    int key = n;
+
+    while (done < n) {
+        for (int j = 0; j < 64 && done < n; j++, done++)
+            TIMED_OP(done, h, ops->insert(H, key--));
+        TIMED_OP(done, h, ops->release(H, ops->extract_min(H)));
+        done++;
+    }
+    return done;
+}
+
+static BenchResult run_case(const BenchHeapOps *ops, int w, int n) {
+    LatHist *h = (LatHist*)malloc(sizeof(LatHist));
+    lat_hist_reset(h);
+
+    void *H = ops->create();
+    unsigned long long t0 = now_ns();
+    long long count = 0;
+
+    switch (w) {
+        case 0: count = bench_insert(ops, H, n, h); break;
+        case 1: count = bench_extract(ops, H, n, h, &t0); break;
+        case 2: count = bench_decrease(ops, H, n, h, &t0); break;
+        case 3: count = bench_random(ops, H, n, h); break;
+        case 4: count = bench_stream(ops, H, n, h, 1); break;
+        case 5: count = bench_stream(ops, H, n, h, -1); break;
+        case 6: count = bench_adversarial(ops, H, n, h); break;
+    }
+
+    unsigned long long elapsed = now_ns() - t0;
+    ops->destroy(H);
+
+    BenchResult r;
+    r.ops = count;
+    r.ns_per_op = count ? (double)elapsed / count : 0.0;
+    r.p50 = lat_hist_percentile(h, 50.0);
+    r.p90 = lat_hist_percentile(h, 90.0);
+    r.p99 = lat_hist_percentile(h, 99.0);
+    r.p999 = lat_hist_percentile(h, 99.9);
+    r.max = h->max;
+    free(h);
+    return r;
+}
+
+/* ============================
+   DRIVER
+   ============================ */
+static void run_forked(const BenchHeapOps *ops, int w, int n, unsigned long long seed) {
+    int fd[2];
+    if (pipe(fd) != 0) {
+        perror("pipe");
+        exit(1);
+    }
+
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fd[0]);
+        rng_state = seed;
+        BenchResult r = run_case(ops, w, n);
+        if (write(fd[1], &r, sizeof(r)) != (ssize_t)sizeof(r))
+            _exit(2);
+        _exit(0);
+    }
+
+    close(fd[1]);
+    BenchResult r;
+    ssize_t got = read(fd[0], &r, sizeof(r));
+    close(fd[0]);
+
+    int status;
+    struct rusage ru;
+    wait4(pid, &status, 0, &ru);
+
+    printf("%-9s %-12s %10d ", ops->name, workloads[w], n);
+    if (WIFSIGNALED(status)) {
+        printf("crashed (signal %d)\n", WTERMSIG(status));
+    } else if (got != (ssize_t)sizeof(r)) {
+        printf("failed (exit %d)\n", WEXITSTATUS(status));
+    } else {
+        printf("%9.1f %8llu %8llu %8llu %8llu %10llu %9.1f\n",
+               r.ns_per_op, r.p50, r.p90, r.p99, r.p999, r.max,
+               ru.ru_maxrss / 1024.0);
+    }
+}
+
+/* "1e3,1e5" is a list, "1e3:1e8" every power of ten in between */
+static int parse_sizes(const char *arg, int *sizes, int max) {
+    int count = 0;
+    const char *colon = strchr(arg, ':');
+
+    if (colon) {
+        double lo = strtod(arg, NULL), hi = strtod(colon + 1, NULL);
+        for (double v = lo; v <= hi * 1.0001 && count < max; v *= 10)
+            sizes[count++] = (int)v;
+        return count;
+    }
+
+    char *copy = strdup(arg);
+    for (char *tok = strtok(copy, ","); tok && count < max; tok = strtok(NULL, ","))
+        sizes[count++] = (int)strtod(tok, NULL);
+    free(copy);
+    return count;
+}
+
+int main(int argc, char **argv) {
+    const BenchHeapOps *impls[] = {
+        &bench_original_ops, &bench_modified_ops, &bench_template_ops,
+        &bench_compact_ops
+    };
+    int num_impls = (int)(sizeof(impls) / sizeof(impls[0]));
+    int use_impl[8];
+    int use_wl[NUM_WORKLOADS];
+    int sizes[16] = { 1000, 10000, 100000, 1000000 };
+    int num_sizes = 4;
+    unsigned long long seed = 88172645463325252ULL;
+
+    for (int w = 0; w < NUM_WORKLOADS; w++)
+        use_wl[w] = 1;
+    for (int i = 0; i < num_impls; i++)
+        use_impl[i] = 1;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "i:w:n:s:")) != -1) {
+        switch (opt) {
+            case 'i':
+                for (int i = 0; i < num_impls; i++)
+                    use_impl[i] = strstr(optarg, impls[i]->name) != NULL
+                                  || !strcmp(optarg, "all");
+                break;
+            case 'w':
+                for (int w = 0; w < NUM_WORKLOADS; w++)
+                    use_wl[w] = strstr(optarg, workloads[w]) != NULL;
+                break;
+            case 'n':
+                num_sizes = parse_sizes(optarg, sizes, 16);
+                break;
+            case 's':
+                seed = strtoull(optarg, NULL, 10) | 1;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-i original|modified|template|compact|all] [-w list] [-n sizes] [-s seed]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    printf("%-9s %-12s %10s %9s %8s %8s %8s %8s %10s %9s\n",
+           "impl", "workload", "n", "ns/op", "p50", "p90", "p99", "p99.9", "max", "rss(MB)");
+
+    for (int w = 0; w < NUM_WORKLOADS; w++) {
+        if (!use_wl[w]) continue;
+        for (int s = 0; s < num_sizes; s++) {
+            for (int i = 0; i < num_impls; i++) {
+                if (use_impl[i])
+                    run_forked(impls[i], w, sizes[s], seed);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+#ifndef BENCH_IMPL_H
+#define BENCH_IMPL_H
+
+/* Uniform view of one heap implementation for the benchmark driver.
+   Heaps and nodes are opaque, since fib_heap.c and modified_fib_heap.c
+   lay out FibNode differently. */
+typedef struct BenchHeapOps {
+    const char *name;
+    void* (*create)(void);
+    void* (*insert)(void *H, int key);
+    void* (*extract_min)(void *H);
+    void  (*decrease_key)(void *H, void *x, int k);
+    int   (*key_of)(void *H, void *x);
+    int   (*size)(void *H);
+    void  (*release)(void *H, void *x);
+    void  (*destroy)(void *H);
+} BenchHeapOps;
+
+extern const BenchHeapOps bench_original_ops;
+extern const BenchHeapOps bench_modified_ops;
+extern const BenchHeapOps bench_template_ops;
+extern const BenchHeapOps bench_compact_ops;
+
+#endif
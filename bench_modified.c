@@ -0,0 +1,17 @@
+/* modified_fib_heap.c behind the benchmark's BenchHeapOps interface */
+#include "modified_fib_heap.h"
+#include "bench_impl.h"
+
+static void* b_create(void) { return make_fib_heap(); }
+static void* b_insert(void *H, int key) { return fib_heap_insert((FibHeap*)H, key); }
+static void* b_extract_min(void *H) { return fib_heap_extract_min((FibHeap*)H); }
+static void b_decrease_key(void *H, void *x, int k) { fib_heap_decrease_key((FibHeap*)H, (FibNode*)x, k); }
+static int b_key_of(void *H, void *x) { (void)H; return ((FibNode*)x)->key; }
+static int b_size(void *H) { return ((FibHeap*)H)->n; }
+static void b_release(void *H, void *x) { fib_heap_release_node((FibHeap*)H, (FibNode*)x); }
+static void b_destroy(void *H) { fib_heap_free((FibHeap*)H); }
+
+const BenchHeapOps bench_modified_ops = {
+    "modified", b_create, b_insert, b_extract_min, b_decrease_key,
+    b_key_of, b_size, b_release, b_destroy
+};
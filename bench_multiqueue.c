@@ -0,0 +1,190 @@
+/* ============================
+   MULTIQUEUE STRESS TEST AND SCALING BENCHMARK
+   ============================
+     gcc -O2 -pthread bench_multiqueue.c multiqueue.c -o bench_mq
+
+   Usage: ./bench_mq stress [threads] [items_per_thread]
+          ./bench_mq scale  [max_threads] [ops_per_thread]
+
+   stress: every thread inserts its own values while extracting, then all
+   threads drain the queue. Checks that every value comes out exactly once.
+   scale: alternating insert/extract on a prefilled queue for 1, 2, 4, ...
+   threads; prints throughput and speedup over one thread.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#include "multiqueue.h"
+
+typedef struct Worker {
+    pthread_t thread;
+    int tid;
+    int count;
+    MultiQueue *Q;
+    atomic_uchar *seen;
+    long long extracted;
+    long long bad;
+} Worker;
+
+static atomic_int start_flag;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static unsigned int worker_rand(unsigned long long *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 7;
+    *s ^= *s << 17;
+    return (unsigned int)(*s >> 33);
+}
+
+static void wait_for_start(void) {
+    while (!atomic_load(&start_flag))
+        ;
+}
+
+/* ============================
+   STRESS TEST
+   ============================ */
+static void note_value(Worker *w, int value) {
+    w->extracted++;
+    if (value < 0 || atomic_fetch_add(&w->seen[value], 1) != 0)
+        w->bad++;
+}
+
+static void* stress_worker(void *arg) {
+    Worker *w = (Worker*)arg;
+    unsigned long long rng = 0x2545F4914F6CDD1DULL * (w->tid + 1);
+    int key, value;
+
+    wait_for_start();
+    for (int i = 0; i < w->count; i++) {
+        int v = w->tid * w->count + i;
+        multiqueue_insert(w->Q, (int)(worker_rand(&rng) % 1000000u), v);
+        if (i % 3 == 2 && multiqueue_extract_min(w->Q, &key, &value))
+            note_value(w, value);
+    }
+    while (multiqueue_extract_min(w->Q, &key, &value))
+        note_value(w, value);
+    return NULL;
+}
+
+static int run_stress(int threads, int per_thread) {
+    long long total = (long long)threads * per_thread;
+    MultiQueue *Q = make_multiqueue(threads, 2);
+    atomic_uchar *seen = (atomic_uchar*)calloc(total, sizeof(atomic_uchar));
+    Worker *w = (Worker*)calloc(threads, sizeof(Worker));
+
+    atomic_store(&start_flag, 0);
+    for (int t = 0; t < threads; t++) {
+        w[t].tid = t;
+        w[t].count = per_thread;
+        w[t].Q = Q;
+        w[t].seen = seen;
+        pthread_create(&w[t].thread, NULL, stress_worker, &w[t]);
+    }
+    atomic_store(&start_flag, 1);
+
+    long long extracted = 0, bad = 0;
+    for (int t = 0; t < threads; t++) {
+        pthread_join(w[t].thread, NULL);
+        extracted += w[t].extracted;
+        bad += w[t].bad;
+    }
+
+    long long missing = 0;
+    for (long long i = 0; i < total; i++) {
+        if (seen[i] == 0)
+            missing++;
+    }
+
+    printf("stress: %d threads, %lld items, extracted %lld, duplicates %lld, missing %lld, left %d\n",
+           threads, total, extracted, bad, missing, multiqueue_size(Q));
+    int ok = (bad == 0 && missing == 0 && extracted == total && multiqueue_size(Q) == 0);
+    printf("%s\n", ok ? "PASS" : "FAIL");
+
+    free(w);
+    free(seen);
+    multiqueue_free(Q);
+    return ok ? 0 : 1;
+}
+
+/* ============================
+   SCALING BENCHMARK
+   ============================ */
+static void* scale_worker(void *arg) {
+    Worker *w = (Worker*)arg;
+    unsigned long long rng = 0x2545F4914F6CDD1DULL * (w->tid + 1);
+    int key, value;
+
+    wait_for_start();
+    for (int i = 0; i < w->count; i++) {
+        multiqueue_insert(w->Q, (int)(worker_rand(&rng) % 1000000u), i);
+        multiqueue_extract_min(w->Q, &key, &value);
+    }
+    return NULL;
+}
+
+static void run_scale(int max_threads, int per_thread) {
+    double base = 0;
+    printf("%8s %12s %10s\n", "threads", "Mops/s", "speedup");
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        MultiQueue *Q = make_multiqueue(threads, 2);
+        Worker *w = (Worker*)calloc(threads, sizeof(Worker));
+
+        unsigned long long rng = 88172645463325252ULL;
+        for (int i = 0; i < 1000000; i++)
+            multiqueue_insert(Q, (int)(worker_rand(&rng) % 1000000u), i);
+
+        atomic_store(&start_flag, 0);
+        for (int t = 0; t < threads; t++) {
+            w[t].tid = t;
+            w[t].count = per_thread;
+            w[t].Q = Q;
+            pthread_create(&w[t].thread, NULL, scale_worker, &w[t]);
+        }
+        double t0 = now_ns();
+        atomic_store(&start_flag, 1);
+        for (int t = 0; t < threads; t++)
+            pthread_join(w[t].thread, NULL);
+        double secs = (now_ns() - t0) / 1e9;
+
+        double mops = 2.0 * threads * per_thread / secs / 1e6;
+        if (threads == 1)
+            base = mops;
+        printf("%8d %12.2f %9.2fx\n", threads, mops, mops / base);
+
+        free(w);
+        multiqueue_free(Q);
+    }
+}
+
+int main(int argc, char **argv) {
+    const char *mode = (argc > 1) ? argv[1] : "stress";
+    int cores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (strcmp(mode, "stress") == 0) {
+        int threads = (argc > 2) ? atoi(argv[2]) : (cores > 1 ? cores : 4);
+        int items = (argc > 3) ? atoi(argv[3]) : 200000;
+        return run_stress(threads, items);
+    }
+    if (strcmp(mode, "scale") == 0) {
+        int threads = (argc > 2) ? atoi(argv[2]) : cores;
+        int ops = (argc > 3) ? atoi(argv[3]) : 1000000;
+        printf("%d online cores\n", cores);
+        run_scale(threads, ops);
+        return 0;
+    }
+
+    fprintf(stderr, "usage: %s stress|scale [threads] [count]\n", argv[0]);
+    return 1;
+}
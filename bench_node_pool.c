@@ -0,0 +1,82 @@
+/* ============================
+   NODE POOL BENCHMARK
+   ============================
+   Times the slab/freelist node pool against the plain malloc path.
+   Build both variants and compare their output:
+
+     gcc -O2 -DFIB_HEAP_NO_MAIN bench_node_pool.c modified_fib_heap.c -lm -o bench_pool
+     gcc -O2 -DFIB_HEAP_NO_MAIN -DFIB_HEAP_NO_POOL bench_node_pool.c modified_fib_heap.c -lm -o bench_malloc
+
+   Usage: ./bench_pool [n] [rounds]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "modified_fib_heap.h"
+
+static unsigned long long rng_state = 88172645463325252ULL;
+
+static int next_key(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (int)(rng_state % 1000000000ULL);
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+    int rounds = (argc > 2) ? atoi(argv[2]) : 5;
+
+#ifndef FIB_HEAP_NO_POOL
+    printf("allocator: node pool\n");
+#else
+    printf("allocator: malloc\n");
+#endif
+    printf("n = %d, rounds = %d\n\n", n, rounds);
+
+    double t_insert = 0, t_extract = 0, t_churn = 0, t_free = 0;
+
+    for (int r = 0; r < rounds; r++) {
+        FibHeap *H = make_fib_heap();
+
+        /* fill: one allocation per insert */
+        double t0 = now_ns();
+        for (int i = 0; i < n; i++)
+            fib_heap_insert(H, next_key());
+        t_insert += now_ns() - t0;
+
+        /* drain half: every node goes back to the allocator */
+        t0 = now_ns();
+        for (int i = 0; i < n / 2; i++)
+            fib_heap_release_node(H, fib_heap_extract_min(H));
+        t_extract += now_ns() - t0;
+
+        /* churn: insert/extract pairs reuse recycled nodes */
+        t0 = now_ns();
+        for (int i = 0; i < n / 2; i++) {
+            fib_heap_insert(H, next_key());
+            fib_heap_release_node(H, fib_heap_extract_min(H));
+        }
+        t_churn += now_ns() - t0;
+
+        /* teardown with n/2 live nodes */
+        t0 = now_ns();
+        fib_heap_free(H);
+        t_free += now_ns() - t0;
+    }
+
+    printf("%-10s %12s\n", "phase", "ns/op");
+    printf("%-10s %12.1f\n", "insert", t_insert / ((double)rounds * n));
+    printf("%-10s %12.1f\n", "extract", t_extract / ((double)rounds * (n / 2)));
+    printf("%-10s %12.1f\n", "churn", t_churn / ((double)rounds * (n / 2)));
+    printf("%-10s %12.3f ms\n", "free", t_free / rounds / 1e6);
+
+    return 0;
+}
@@ -0,0 +1,32 @@
+/* fib_heap.c compiled under renamed symbols, so the benchmark can link it
+   next to modified_fib_heap.c in one binary. */
+#ifndef FIB_HEAP_NO_MAIN
+#define FIB_HEAP_NO_MAIN
+#endif
+#define make_fib_heap          orig_make_fib_heap
+#define make_fib_node          orig_make_fib_node
+#define fib_heap_insert        orig_fib_heap_insert
+#define fib_heap_min           orig_fib_heap_min
+#define fib_heap_union         orig_fib_heap_union
+#define fib_heap_extract_min   orig_fib_heap_extract_min
+#define fib_heap_decrease_key  orig_fib_heap_decrease_key
+#define fib_heap_delete        orig_fib_heap_delete
+#define fib_heap_print         orig_fib_heap_print
+#define fib_heap_free          orig_fib_heap_free
+
+#include "fib_heap.c"
+#include "bench_impl.h"
+
+static void* b_create(void) { return make_fib_heap(); }
+static void* b_insert(void *H, int key) { return fib_heap_insert((FibHeap*)H, key); }
+static void* b_extract_min(void *H) { return fib_heap_extract_min((FibHeap*)H); }
+static void b_decrease_key(void *H, void *x, int k) { fib_heap_decrease_key((FibHeap*)H, (FibNode*)x, k); }
+static int b_key_of(void *H, void *x) { (void)H; return ((FibNode*)x)->key; }
+static int b_size(void *H) { return ((FibHeap*)H)->n; }
+static void b_release(void *H, void *x) { (void)H; free(x); }
+static void b_destroy(void *H) { fib_heap_free((FibHeap*)H); }
+
+const BenchHeapOps bench_original_ops = {
+    "original", b_create, b_insert, b_extract_min, b_decrease_key,
+    b_key_of, b_size, b_release, b_destroy
+};
@@ -0,0 +1,125 @@
+/* ============================
+   POINT-TO-POINT QUERY BENCHMARK
+   ============================
+   Random s-t queries on a side x side grid with coordinates. Edge weights
+   are 10..100 per unit step, so 10 * Euclidean distance is admissible.
+   Compares a full dijkstra() sweep with dijkstra_to, dijkstra_bidir and
+   dijkstra_astar, and checks that every answer matches.
+
+     gcc -O2 -DFIB_HEAP_NO_MAIN bench_p2p.c dijkstra.c graph.c pq_backend.c \
+         modified_fib_heap.c pairing_heap.c dary_heap.c radix_heap.c -lm -o bench_p2p
+
+   Usage: ./bench_p2p [side] [queries]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "dijkstra.h"
+
+static unsigned long long rng_state = 88172645463325252ULL;
+
+static unsigned int next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (unsigned int)(rng_state >> 11);
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+typedef struct Totals {
+    double ns;
+    long long settled;
+} Totals;
+
+static void report(const char *name, Totals *t, int q) {
+    printf("%-10s %12.1f %14.0f\n", name, t->ns / q / 1e3, (double)t->settled / q);
+}
+
+int main(int argc, char **argv) {
+    int side = (argc > 1) ? atoi(argv[1]) : 700;
+    int queries = (argc > 2) ? atoi(argv[2]) : 50;
+    int n = side * side;
+
+    int m = 4 * n;
+    int *src = (int*)malloc(m * sizeof(int));
+    int *dst = (int*)malloc(m * sizeof(int));
+    int *w = (int*)malloc(m * sizeof(int));
+    double *x = (double*)malloc(n * sizeof(double));
+    double *y = (double*)malloc(n * sizeof(double));
+    int k = 0;
+
+    for (int u = 0; u < n; u++) {
+        int r = u / side, c = u % side;
+        x[u] = c;
+        y[u] = r;
+        int nb[4] = { r > 0 ? u - side : -1, r + 1 < side ? u + side : -1,
+                      c > 0 ? u - 1 : -1, c + 1 < side ? u + 1 : -1 };
+        for (int i = 0; i < 4; i++) {
+            if (nb[i] < 0) continue;
+            src[k] = u;
+            dst[k] = nb[i];
+            w[k] = 10 + next_rand() % 91;
+            k++;
+        }
+    }
+
+    Graph *G = make_graph(n, k, src, dst, w);
+    Graph *Gr = graph_transpose(G);
+    AStarCoords coords = { x, y, 10.0 };
+    int *dist = (int*)malloc(n * sizeof(int));
+    Totals full = {0, 0}, to = {0, 0}, bi = {0, 0}, as = {0, 0};
+
+    for (int q = 0; q < queries; q++) {
+        int s = next_rand() % n, t = next_rand() % n;
+        QueryStats st;
+
+        double t0 = now_ns();
+        dijkstra(G, s, dist, NULL);
+        full.ns += now_ns() - t0;
+        full.settled += n;
+
+        t0 = now_ns();
+        int d1 = dijkstra_to(G, s, t, &st);
+        to.ns += now_ns() - t0;
+        to.settled += st.settled;
+
+        t0 = now_ns();
+        int d2 = dijkstra_bidir(G, Gr, s, t, &st);
+        bi.ns += now_ns() - t0;
+        bi.settled += st.settled;
+
+        t0 = now_ns();
+        int d3 = dijkstra_astar(G, s, t, NULL, &coords, &st);
+        as.ns += now_ns() - t0;
+        as.settled += st.settled;
+
+        if (d1 != dist[t] || d2 != dist[t] || d3 != dist[t]) {
+            printf("MISMATCH s=%d t=%d: full %d, to %d, bidir %d, astar %d\n",
+                   s, t, dist[t], d1, d2, d3);
+            return 1;
+        }
+    }
+
+    printf("grid %dx%d, %d queries (all distances match)\n\n", side, side, queries);
+    printf("%-10s %12s %14s\n", "mode", "us/query", "settled/query");
+    report("full", &full, queries);
+    report("to", &to, queries);
+    report("bidir", &bi, queries);
+    report("astar", &as, queries);
+
+    free(dist);
+    free(x);
+    free(y);
+    free(src);
+    free(dst);
+    free(w);
+    graph_free(Gr);
+    graph_free(G);
+    return 0;
+}
@@ -0,0 +1,190 @@
+/* ============================
+   PRIORITY-QUEUE BACKEND BENCHMARK
+   ============================
+   Runs the same workloads on every backend in pq_backend.h and prints
+   ns per operation side by side.
+
+     gcc -O2 -DFIB_HEAP_NO_MAIN bench_pq_backends.c pq_backend.c modified_fib_heap.c \
+         pairing_heap.c dary_heap.c radix_heap.c dijkstra.c graph.c -lm -o bench_pq
+
+   Usage: ./bench_pq [n] [backend ...]      (default: 1000000, all backends)
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "pq_backend.h"
+#include "dijkstra.h"
+
+static unsigned long long rng_state;
+
+static unsigned int next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (unsigned int)(rng_state >> 11);
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* ============================
+   WORKLOADS
+   ============================
+   Each returns ns per heap operation. */
+
+/* n random inserts, then drain */
+static double run_random(const PQBackend *pq, int n) {
+    void *H = pq->create();
+    int key, id;
+
+    double t0 = now_ns();
+    for (int i = 0; i < n; i++)
+        pq->insert(H, (int)(next_rand() % 1000000000u), i);
+    while (pq->extract_min(H, &key, &id))
+        ;
+    double t = now_ns() - t0;
+
+    pq->destroy(H);
+    return t / (2.0 * n);
+}
+
+/* n inserts, n random decrease-keys, then drain */
+static double run_decrease(const PQBackend *pq, int n) {
+    void *H = pq->create();
+    PQHandle *h = (PQHandle*)malloc(n * sizeof(PQHandle));
+    int *keys = (int*)malloc(n * sizeof(int));
+    int key, id;
+
+    double t0 = now_ns();
+    for (int i = 0; i < n; i++) {
+        keys[i] = 500000000 + (int)(next_rand() % 500000000u);
+        h[i] = pq->insert(H, keys[i], i);
+    }
+    for (int i = 0; i < n; i++) {
+        int v = next_rand() % n;
+        keys[v] -= (int)(next_rand() % 1000u);
+        pq->decrease_key(H, h[v], keys[v]);
+    }
+    while (pq->extract_min(H, &key, &id))
+        ;
+    double t = now_ns() - t0;
+
+    free(keys);
+    free(h);
+    pq->destroy(H);
+    return t / (3.0 * n);
+}
+
+/* steady-state churn at size n/8: insert, extract, occasional delete.
+   New keys are drawn above the last extracted one, as in Dijkstra, so
+   monotone backends run the same stream. */
+static double run_mixed(const PQBackend *pq, int n) {
+    int size = n / 8 > 0 ? n / 8 : 1;
+    void *H = pq->create();
+    PQHandle *h = (PQHandle*)malloc(n * sizeof(PQHandle));
+    int key = 0, id, ops = 0;
+
+    double t0 = now_ns();
+    for (int i = 0; i < size; i++, ops++)
+        h[i] = pq->insert(H, (int)(next_rand() % 1000000u), i);
+    for (int i = size; i < n; i++) {
+        h[i] = pq->insert(H, key + (int)(next_rand() % 1000000u), i);
+        pq->extract_min(H, &key, &id);
+        h[id] = NULL;
+        ops += 2;
+        if (i % 4 == 0) {
+            int v = i - (int)(next_rand() % size);
+            if (h[v] != NULL) {
+                pq->remove(H, h[v]);
+                h[v] = NULL;
+                ops++;
+            }
+        }
+    }
+    double t = now_ns() - t0;
+
+    free(h);
+    pq->destroy(H);
+    return t / ops;
+}
+
+/* Dijkstra on a random graph with n vertices and 8n edges; ns per edge */
+static double run_dijkstra(const PQBackend *pq, const Graph *G, int *dist) {
+    double t0 = now_ns();
+    dijkstra_with(G, 0, dist, NULL, pq);
+    return (now_ns() - t0) / G->m;
+}
+
+static Graph* random_graph(int n, int deg) {
+    int m = n * deg;
+    int *src = (int*)malloc(m * sizeof(int));
+    int *dst = (int*)malloc(m * sizeof(int));
+    int *w = (int*)malloc(m * sizeof(int));
+    for (int e = 0; e < m; e++) {
+        src[e] = e / deg;
+        dst[e] = next_rand() % n;
+        w[e] = 1 + next_rand() % 1000;
+    }
+    Graph *G = make_graph(n, m, src, dst, w);
+    free(src);
+    free(dst);
+    free(w);
+    return G;
+}
+
+/* ============================
+   MAIN
+   ============================ */
+int main(int argc, char **argv) {
+    int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+    if (n <= 0) {
+        fprintf(stderr, "n must be positive\n");
+        return 1;
+    }
+
+    const PQBackend *chosen[8];
+    int nb = 0;
+    for (int i = 2; i < argc && nb < 8; i++) {
+        chosen[nb] = pq_backend_by_name(argv[i]);
+        if (chosen[nb] == NULL) {
+            fprintf(stderr, "unknown backend: %s\n", argv[i]);
+            return 1;
+        }
+        nb++;
+    }
+    if (nb == 0) {
+        for (; pq_backends[nb] != NULL; nb++)
+            chosen[nb] = pq_backends[nb];
+    }
+
+    rng_state = 88172645463325252ULL;
+    Graph *G = random_graph(n, 8);
+    int *dist = (int*)malloc(n * sizeof(int));
+
+    printf("n = %d (ns per op; dijkstra: ns per edge)\n\n", n);
+    printf("%-10s %10s %10s %10s %10s\n", "backend", "random", "decrease", "mixed", "dijkstra");
+
+    for (int b = 0; b < nb; b++) {
+        const PQBackend *pq = chosen[b];
+        double r[4];
+
+        /* same key stream for every backend */
+        rng_state = 88172645463325252ULL;
+        r[0] = run_random(pq, n);
+        rng_state = 88172645463325252ULL;
+        r[1] = run_decrease(pq, n);
+        rng_state = 88172645463325252ULL;
+        r[2] = run_mixed(pq, n);
+        r[3] = run_dijkstra(pq, G, dist);
+
+        printf("%-10s %10.1f %10.1f %10.1f %10.1f\n", pq->name, r[0], r[1], r[2], r[3]);
+    }
+
+    free(dist);
+    graph_free(G);
+    return 0;
+}
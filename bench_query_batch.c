@@ -0,0 +1,120 @@
+/* ============================
+   BATCH QUERY BENCHMARK
+   ============================
+   Random s-t queries on a grid: one-shot dijkstra_to per query (fresh heap
+   and O(n) arrays every time) against query_engine_run with 1, 2, 4, ...
+   workers, in early-exit and bidirectional mode. The sink checks that
+   results arrive in order and match the one-shot answers.
+
+     gcc -O2 -pthread -DFIB_HEAP_NO_MAIN bench_query_batch.c query_batch.c \
+         dijkstra.c graph.c pq_backend.c modified_fib_heap.c pairing_heap.c \
+         dary_heap.c radix_heap.c -lm -o bench_qb
+
+   Usage: ./bench_qb [side] [queries] [max_threads]
+   Pairs are drawn within a 40-step window, like local traffic.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "query_batch.h"
+
+static unsigned long long rng_state = 88172645463325252ULL;
+
+static unsigned int next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (unsigned int)(rng_state >> 11);
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+typedef struct Check {
+    const int *expect;
+    int next;
+    int bad;
+} Check;
+
+static void check_sink(int index, const QueryPair *q, int dist, const QueryStats *stats, void *ctx) {
+    (void)q;
+    (void)stats;
+    Check *c = (Check*)ctx;
+    if (index != c->next || dist != c->expect[index])
+        c->bad++;
+    c->next++;
+}
+
+int main(int argc, char **argv) {
+    int side = (argc > 1) ? atoi(argv[1]) : 1000;
+    int queries = (argc > 2) ? atoi(argv[2]) : 2000;
+    int max_threads = (argc > 3) ? atoi(argv[3]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int n = side * side;
+
+    int m = 4 * n, k = 0;
+    int *src = (int*)malloc(m * sizeof(int));
+    int *dst = (int*)malloc(m * sizeof(int));
+    int *w = (int*)malloc(m * sizeof(int));
+    for (int u = 0; u < n; u++) {
+        int r = u / side, c = u % side;
+        int nb[4] = { r > 0 ? u - side : -1, r + 1 < side ? u + side : -1,
+                      c > 0 ? u - 1 : -1, c + 1 < side ? u + 1 : -1 };
+        for (int i = 0; i < 4; i++) {
+            if (nb[i] < 0) continue;
+            src[k] = u;
+            dst[k] = nb[i];
+            w[k] = 10 + next_rand() % 91;
+            k++;
+        }
+    }
+    Graph *G = make_graph(n, k, src, dst, w);
+    Graph *Gr = graph_transpose(G);
+    free(src);
+    free(dst);
+    free(w);
+
+    QueryPair *q = (QueryPair*)malloc(queries * sizeof(QueryPair));
+    for (int i = 0; i < queries; i++) {
+        int r = next_rand() % side, c = next_rand() % side;
+        int r2 = r + (int)(next_rand() % 81) - 40, c2 = c + (int)(next_rand() % 81) - 40;
+        r2 = r2 < 0 ? 0 : (r2 >= side ? side - 1 : r2);
+        c2 = c2 < 0 ? 0 : (c2 >= side ? side - 1 : c2);
+        q[i].s = r * side + c;
+        q[i].t = r2 * side + c2;
+    }
+
+    int *expect = (int*)malloc(queries * sizeof(int));
+    double t0 = now_ns();
+    for (int i = 0; i < queries; i++)
+        expect[i] = dijkstra_to(G, q[i].s, q[i].t, NULL);
+    double one_shot = queries / ((now_ns() - t0) / 1e9);
+
+    printf("grid %dx%d, %d queries\n\n", side, side, queries);
+    printf("%-22s %12s\n", "mode", "queries/s");
+    printf("%-22s %12.0f\n", "dijkstra_to one-shot", one_shot);
+
+    for (int mode = 0; mode < 2; mode++) {
+        for (int t = 1; t <= max_threads; t *= 2) {
+            QueryEngine *E = make_query_engine(G, mode ? Gr : NULL, t);
+            Check c = { expect, 0, 0 };
+            double qps = query_engine_run(E, q, queries, check_sink, &c);
+            char name[32];
+            snprintf(name, sizeof(name), "engine %s x%d", mode ? "bidir" : "to", t);
+            printf("%-22s %12.0f  %s\n", name, qps, c.bad ? "MISMATCH" : "ok");
+            query_engine_free(E);
+            if (c.bad)
+                return 1;
+        }
+    }
+
+    free(expect);
+    free(q);
+    graph_free(Gr);
+    graph_free(G);
+    return 0;
+}
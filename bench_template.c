@@ -0,0 +1,19 @@
+/* int instantiation of fib_heap_template.h behind the BenchHeapOps interface */
+#include "fib_heap_template.h"
+#include "bench_impl.h"
+
+FIBHEAP_DEFINE(tfib, int, int, FIBHEAP_LT)
+
+static void* b_create(void) { return tfib_create(); }
+static void* b_insert(void *H, int key) { return tfib_insert((tfib_heap*)H, key, 0); }
+static void* b_extract_min(void *H) { return tfib_extract_min((tfib_heap*)H); }
+static void b_decrease_key(void *H, void *x, int k) { tfib_decrease_key((tfib_heap*)H, (tfib_node*)x, k); }
+static int b_key_of(void *H, void *x) { (void)H; return ((tfib_node*)x)->key; }
+static int b_size(void *H) { return ((tfib_heap*)H)->n; }
+static void b_release(void *H, void *x) { tfib_release((tfib_heap*)H, (tfib_node*)x); }
+static void b_destroy(void *H) { tfib_free((tfib_heap*)H); }
+
+const BenchHeapOps bench_template_ops = {
+    "template", b_create, b_insert, b_extract_min, b_decrease_key,
+    b_key_of, b_size, b_release, b_destroy
+};
@@ -0,0 +1,351 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "compact_fib_heap.h"
+
+#define NODE(i)      (H->nodes[i])
+#define DEGREE(i)    (H->nodes[i].degree_mark >> 1)
+#define MARKED(i)    (H->nodes[i].degree_mark & 1u)
+#define SET_MARK(i)  (H->nodes[i].degree_mark |= 1u)
+#define CLEAR_MARK(i) (H->nodes[i].degree_mark &= ~1u)
+
+/* ============================
+   BASIC CREATION FUNCTIONS
+   ============================ */
+CompactFibHeap* make_compact_fib_heap() {
+    CompactFibHeap *H = (CompactFibHeap*)malloc(sizeof(CompactFibHeap));
+    H->nodes = NULL;
+    H->capacity = 0;
+    H->used = 0;
+    H->free_list = COMPACT_NIL;
+    H->min = COMPACT_NIL;
+    H->n = 0;
+    H->degree_table = NULL;
+    H->degree_cap = 0;
+    return H;
+}
+
+/* Take a released slot, or the next unused one (doubling the array) */
+static uint32_t alloc_slot(CompactFibHeap *H) {
+    uint32_t x = H->free_list;
+    if (x != COMPACT_NIL) {
+        H->free_list = NODE(x).right;
+        return x;
+    }
+
+    if (H->used == H->capacity) {
+        H->capacity = H->capacity ? H->capacity * 2 : 64;
+        H->nodes = (CompactNode*)realloc(H->nodes, (size_t)H->capacity * sizeof(CompactNode));
+    }
+    return H->used++;
+}
+
+void compact_fib_heap_release(CompactFibHeap *H, CompactHandle x) {
+    NODE(x).right = H->free_list;
+    H->free_list = x;
+}
+
+/* Insert into root list */
+static void insert_into_root(CompactFibHeap *H, uint32_t x) {
+    if (H->min == COMPACT_NIL) {
+        H->min = x;
+        NODE(x).left = NODE(x).right = x;
+    } else {
+        uint32_t m = H->min;
+        NODE(x).right = NODE(m).right;
+        NODE(x).left = m;
+        NODE(NODE(m).right).left = x;
+        NODE(m).right = x;
+        if (NODE(x).key < NODE(m).key)
+            H->min = x;
+    }
+}
+
+CompactHandle compact_fib_heap_insert(CompactFibHeap *H, int key) {
+    uint32_t x = alloc_slot(H);
+    NODE(x).key = key;
+    NODE(x).degree_mark = 0;
+    NODE(x).parent = COMPACT_NIL;
+    NODE(x).child = COMPACT_NIL;
+    insert_into_root(H, x);
+    H->n++;
+    return x;
+}
+
+CompactHandle compact_fib_heap_min(CompactFibHeap *H) {
+    return H->min;
+}
+
+/* ============================
+   UNION OF TWO HEAPS
+   ============================
+   Nodes live in per-heap arrays, so H2's nodes are copied behind H1's and
+   every link shifted by the returned offset: a handle h of H2 becomes
+   h + offset in H1. H2 is freed. O(size of H2). */
+uint32_t compact_fib_heap_union(CompactFibHeap *H1, CompactFibHeap *H2) {
+    uint32_t base = H1->used;
+
+    if (H2->used > 0) {
+        uint32_t need = base + H2->used;
+        if (need > H1->capacity) {
+            while (H1->capacity < need)
+                H1->capacity = H1->capacity ? H1->capacity * 2 : 64;
+            H1->nodes = (CompactNode*)realloc(H1->nodes, (size_t)H1->capacity * sizeof(CompactNode));
+        }
+
+        for (uint32_t i = 0; i < H2->used; i++) {
+            CompactNode *d = &H1->nodes[base + i];
+            *d = H2->nodes[i];
+            if (d->parent != COMPACT_NIL) d->parent += base;
+            if (d->child != COMPACT_NIL) d->child += base;
+            if (d->left != COMPACT_NIL) d->left += base;
+            if (d->right != COMPACT_NIL) d->right += base;
+        }
+        H1->used = need;
+
+        /* H2's free slots join H1's freelist */
+        uint32_t f = H2->free_list;
+        while (f != COMPACT_NIL) {
+            uint32_t next = H2->nodes[f].right;
+            H1->nodes[base + f].right = H1->free_list;
+            H1->free_list = base + f;
+            f = next;
+        }
+    }
+
+    if (H2->min != COMPACT_NIL) {
+        CompactFibHeap *H = H1;
+        uint32_t b = H2->min + base;
+        if (H1->min == COMPACT_NIL) {
+            H1->min = b;
+        } else {
+            uint32_t a = H1->min;
+            uint32_t a_right = NODE(a).right;
+            uint32_t b_left = NODE(b).left;
+            NODE(a_right).left = b_left;
+            NODE(b_left).right = a_right;
+            NODE(a).right = b;
+            NODE(b).left = a;
+            if (NODE(b).key < NODE(a).key)
+                H1->min = b;
+        }
+    }
+
+    H1->n += H2->n;
+    compact_fib_heap_free(H2);
+    return base;
+}
+
+/* ============================
+   LINK TWO TREES
+   ============================ */
+static void compact_link(CompactFibHeap *H, uint32_t y, uint32_t x) {
+    /* y's root-list links are rebuilt by consolidate */
+    NODE(y).parent = x;
+    CLEAR_MARK(y);
+
+    uint32_t c = NODE(x).child;
+    if (c == COMPACT_NIL) {
+        NODE(x).child = y;
+        NODE(y).left = NODE(y).right = y;
+    } else {
+        NODE(y).right = NODE(c).right;
+        NODE(y).left = c;
+        NODE(NODE(c).right).left = y;
+        NODE(c).right = y;
+    }
+
+    NODE(x).degree_mark += 2;
+}
+
+/* ============================
+   CONSOLIDATE
+   ============================
+   Single pass: the root ring is opened and walked with the next index
+   saved, then rebuilt from the degree table. */
+static void compact_consolidate(CompactFibHeap *H) {
+    int bits = 0;
+    for (int t = H->n; t > 0; t >>= 1)
+        bits++;
+    int D = (3 * bits) / 2 + 2;
+
+    if (D > H->degree_cap) {
+        int cap = H->degree_cap ? H->degree_cap : 16;
+        while (cap < D)
+            cap *= 2;
+        H->degree_table = (uint32_t*)realloc(H->degree_table, cap * sizeof(uint32_t));
+        for (int i = H->degree_cap; i < cap; i++)
+            H->degree_table[i] = COMPACT_NIL;
+        H->degree_cap = cap;
+    }
+    uint32_t *A = H->degree_table;
+
+    uint32_t w = H->min;
+    NODE(NODE(w).left).right = COMPACT_NIL;
+
+    while (w != COMPACT_NIL) {
+        uint32_t next = NODE(w).right;
+        uint32_t x = w;
+        uint32_t d = DEGREE(x);
+
+        while (A[d] != COMPACT_NIL) {
+            uint32_t y = A[d];
+            if (NODE(y).key < NODE(x).key) {
+                uint32_t tmp = x;
+                x = y;
+                y = tmp;
+            }
+            compact_link(H, y, x);
+            A[d] = COMPACT_NIL;
+            d++;
+        }
+        A[d] = x;
+        w = next;
+    }
+
+    H->min = COMPACT_NIL;
+    for (int i = 0; i < D; i++) {
+        if (A[i] != COMPACT_NIL) {
+            insert_into_root(H, A[i]);
+            A[i] = COMPACT_NIL;
+        }
+    }
+}
+
+/* ============================
+   EXTRACT MINIMUM
+   ============================ */
+CompactHandle compact_fib_heap_extract_min(CompactFibHeap *H) {
+    uint32_t z = H->min;
+    if (z == COMPACT_NIL)
+        return COMPACT_NIL;
+
+    /* splice the child ring into the root ring */
+    uint32_t c = NODE(z).child;
+    if (c != COMPACT_NIL) {
+        uint32_t w = c;
+        do {
+            NODE(w).parent = COMPACT_NIL;
+            w = NODE(w).right;
+        } while (w != c);
+
+        uint32_t c_last = NODE(c).left;
+        NODE(c_last).right = NODE(z).right;
+        NODE(NODE(z).right).left = c_last;
+        NODE(z).right = c;
+        NODE(c).left = z;
+        NODE(z).child = COMPACT_NIL;
+    }
+
+    /* remove z */
+    NODE(NODE(z).left).right = NODE(z).right;
+    NODE(NODE(z).right).left = NODE(z).left;
+
+    if (z == NODE(z).right)
+        H->min = COMPACT_NIL;
+    else {
+        H->min = NODE(z).right;
+        compact_consolidate(H);
+    }
+
+    H->n--;
+    return z;
+}
+
+/* ============================
+   CUT OPERATIONS
+   ============================ */
+static void compact_cut(CompactFibHeap *H, uint32_t x, uint32_t y) {
+    if (NODE(x).right == x)
+        NODE(y).child = COMPACT_NIL;
+    else {
+        if (NODE(y).child == x)
+            NODE(y).child = NODE(x).right;
+        NODE(NODE(x).left).right = NODE(x).right;
+        NODE(NODE(x).right).left = NODE(x).left;
+    }
+
+    NODE(y).degree_mark -= 2;
+
+    NODE(x).parent = COMPACT_NIL;
+    CLEAR_MARK(x);
+
+    insert_into_root(H, x);
+}
+
+static void compact_cascading_cut(CompactFibHeap *H, uint32_t y) {
+    uint32_t z = NODE(y).parent;
+    while (z != COMPACT_NIL) {
+        if (!MARKED(y)) {
+            SET_MARK(y);
+            return;
+        }
+        compact_cut(H, y, z);
+        y = z;
+        z = NODE(y).parent;
+    }
+}
+
+/* ============================
+   DECREASE KEY
+   ============================ */
+/* Returns 0, or -1 if k is larger than the current key */
+int compact_fib_heap_decrease_key(CompactFibHeap *H, CompactHandle x, int k) {
+    if (k > NODE(x).key)
+        return -1;
+
+    NODE(x).key = k;
+    uint32_t y = NODE(x).parent;
+
+    if (y != COMPACT_NIL && NODE(x).key < NODE(y).key) {
+        compact_cut(H, x, y);
+        compact_cascading_cut(H, y);
+    }
+
+    if (NODE(x).key < NODE(H->min).key)
+        H->min = x;
+    return 0;
+}
+
+/* ============================
+   DELETE NODE
+   ============================
+   Cut x to the root list and make it the min, then extract it. */
+void compact_fib_heap_delete(CompactFibHeap *H, CompactHandle x) {
+    uint32_t y = NODE(x).parent;
+    if (y != COMPACT_NIL) {
+        compact_cut(H, x, y);
+        compact_cascading_cut(H, y);
+    }
+    H->min = x;
+    compact_fib_heap_release(H, compact_fib_heap_extract_min(H));
+}
+
+/* ============================
+   PRINT ROOT LIST
+   ============================ */
+void compact_fib_heap_print(CompactFibHeap *H) {
+    if (H->min == COMPACT_NIL) {
+        printf("Heap is empty.\n");
+        return;
+    }
+
+    uint32_t x = H->min;
+    printf("Root list: ");
+    do {
+        printf("%d ", NODE(x).key);
+        x = NODE(x).right;
+    } while (x != H->min);
+
+    printf("\n");
+}
+
+/* ============================
+   FREE HEAP
+   ============================ */
+void compact_fib_heap_free(CompactFibHeap *H) {
+    free(H->nodes);
+    free(H->degree_table);
+    free(H);
+}
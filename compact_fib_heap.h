@@ -0,0 +1,59 @@
+#ifndef COMPACT_FIB_HEAP_H
+#define COMPACT_FIB_HEAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/* Fibonacci heap stored in one contiguous node array. Links are 32-bit
+   indices and degree/mark share one word, so a node is 24 bytes instead
+   of 48. A handle is a node's index. It stays valid until the node is
+   released, even when the array grows. */
+#define COMPACT_NIL 0xFFFFFFFFu
+
+typedef uint32_t CompactHandle;
+
+typedef struct CompactNode {
+    int key;
+    uint32_t degree_mark;   /* degree << 1 | mark */
+    uint32_t parent;
+    uint32_t child;
+    uint32_t left;
+    uint32_t right;
+} CompactNode;
+
+typedef struct CompactFibHeap {
+    CompactNode *nodes;
+    uint32_t capacity;
+    uint32_t used;          /* slots ever handed out */
+    uint32_t free_list;     /* released slots, linked through right */
+    uint32_t min;
+    int n;
+    uint32_t *degree_table; /* consolidate scratch, all NIL between calls */
+    int degree_cap;
+} CompactFibHeap;
+
+/* Creation */
+CompactFibHeap* make_compact_fib_heap();
+
+/* Operations */
+CompactHandle compact_fib_heap_insert(CompactFibHeap *H, int key);
+CompactHandle compact_fib_heap_min(CompactFibHeap *H);
+uint32_t compact_fib_heap_union(CompactFibHeap *H1, CompactFibHeap *H2);
+CompactHandle compact_fib_heap_extract_min(CompactFibHeap *H);
+int compact_fib_heap_decrease_key(CompactFibHeap *H, CompactHandle x, int k);
+void compact_fib_heap_delete(CompactFibHeap *H, CompactHandle x);
+
+/* Node access */
+static inline int compact_fib_heap_key(const CompactFibHeap *H, CompactHandle x) {
+    return H->nodes[x].key;
+}
+
+/* Utility */
+void compact_fib_heap_print(CompactFibHeap *H);
+void compact_fib_heap_free(CompactFibHeap *H);
+
+/* Memory: give back a handle returned by compact_fib_heap_extract_min */
+void compact_fib_heap_release(CompactFibHeap *H, CompactHandle x);
+
+#endif
@@ -0,0 +1,213 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dary_heap.h"
+
+/* ============================
+   BASIC CREATION FUNCTIONS
+   ============================ */
+DaryHeap* make_dary_heap() {
+    DaryHeap *H = (DaryHeap*)malloc(sizeof(DaryHeap));
+    H->a = NULL;
+    H->n = 0;
+    H->cap = 0;
+    H->pos = NULL;
+    H->pos_cap = 0;
+    return H;
+}
+
+/* Returns -1 if id is outside [0, DARY_ID_MAX] or pos cannot grow */
+static int reserve_id(DaryHeap *H, int id) {
+    if (id < 0 || id > DARY_ID_MAX)
+        return -1;
+    if (id < H->pos_cap)
+        return 0;
+
+    size_t cap = H->pos_cap ? (size_t)H->pos_cap : 64;
+    while (cap <= (size_t)id)
+        cap *= 2;
+
+    int *t = (int*)realloc(H->pos, cap * sizeof(int));
+    if (t == NULL)
+        return -1;
+    H->pos = t;
+    for (size_t i = (size_t)H->pos_cap; i < cap; i++)
+        H->pos[i] = -1;
+    H->pos_cap = (int)cap;
+    return 0;
+}
+
+static void reserve_slots(DaryHeap *H, int n) {
+    if (n <= H->cap)
+        return;
+
+    int cap = H->cap ? H->cap : 64;
+    while (cap < n)
+        cap *= 2;
+    H->a = (DaryEntry*)realloc(H->a, cap * sizeof(DaryEntry));
+    H->cap = cap;
+}
+
+/* ============================
+   SIFT UP / DOWN
+   ============================ */
+static void sift_up(DaryHeap *H, int i) {
+    DaryEntry e = H->a[i];
+    while (i > 0) {
+        int p = (i - 1) / DARY_ARITY;
+        if (H->a[p].key <= e.key)
+            break;
+        H->a[i] = H->a[p];
+        H->pos[H->a[i].id] = i;
+        i = p;
+    }
+    H->a[i] = e;
+    H->pos[e.id] = i;
+}
+
+static void sift_down(DaryHeap *H, int i) {
+    DaryEntry e = H->a[i];
+    for (;;) {
+        int first = i * DARY_ARITY + 1;
+        if (first >= H->n)
+            break;
+
+        int last = first + DARY_ARITY;
+        if (last > H->n)
+            last = H->n;
+
+        int best = first;
+        for (int c = first + 1; c < last; c++) {
+            if (H->a[c].key < H->a[best].key)
+                best = c;
+        }
+        if (e.key <= H->a[best].key)
+            break;
+
+        H->a[i] = H->a[best];
+        H->pos[H->a[i].id] = i;
+        i = best;
+    }
+    H->a[i] = e;
+    H->pos[e.id] = i;
+}
+
+/* ============================
+   OPERATIONS
+   ============================ */
+int dary_heap_insert(DaryHeap *H, int key, int id) {
+    if (dary_heap_contains(H, id) || reserve_id(H, id) != 0)
+        return -1;
+
+    reserve_slots(H, H->n + 1);
+    H->a[H->n].key = key;
+    H->a[H->n].id = id;
+    H->n++;
+    sift_up(H, H->n - 1);
+    return 0;
+}
+
+int dary_heap_contains(DaryHeap *H, int id) {
+    return id >= 0 && id < H->pos_cap && H->pos[id] >= 0;
+}
+
+/* Returns 0 if the heap is empty */
+int dary_heap_min(DaryHeap *H, int *key, int *id) {
+    if (H->n == 0)
+        return 0;
+    *key = H->a[0].key;
+    *id = H->a[0].id;
+    return 1;
+}
+
+/* Remove the entry in slot i and restore heap order */
+static void remove_slot(DaryHeap *H, int i) {
+    H->pos[H->a[i].id] = -1;
+    H->n--;
+    if (i == H->n)
+        return;
+
+    int old = H->a[i].key;
+    H->a[i] = H->a[H->n];
+    H->pos[H->a[i].id] = i;
+    if (H->a[i].key < old)
+        sift_up(H, i);
+    else
+        sift_down(H, i);
+}
+
+/* Returns 0 if the heap is empty */
+int dary_heap_extract_min(DaryHeap *H, int *key, int *id) {
+    if (!dary_heap_min(H, key, id))
+        return 0;
+    remove_slot(H, 0);
+    return 1;
+}
+
+/* Returns 0, or -1 if the id is absent or k is larger */
+int dary_heap_decrease_key(DaryHeap *H, int id, int k) {
+    if (!dary_heap_contains(H, id))
+        return -1;
+
+    int i = H->pos[id];
+    if (k > H->a[i].key)
+        return -1;
+
+    H->a[i].key = k;
+    sift_up(H, i);
+    return 0;
+}
+
+/* Returns 0, or -1 if the id is absent */
+int dary_heap_delete(DaryHeap *H, int id) {
+    if (!dary_heap_contains(H, id))
+        return -1;
+    remove_slot(H, H->pos[id]);
+    return 0;
+}
+
+/* ============================
+   UNION OF TWO HEAPS
+   ============================
+   Appends the smaller heap's entries to the larger one and heapifies
+   bottom-up in O(n1 + n2). Ids must be unique across both heaps. Returns
+   NULL, with both heaps unchanged, if the id table cannot grow. */
+DaryHeap* dary_heap_union(DaryHeap *H1, DaryHeap *H2) {
+    if (H1->n < H2->n) {
+        DaryHeap *t = H1;
+        H1 = H2;
+        H2 = t;
+    }
+
+    /* reserving the largest id covers every id H2 brings */
+    int max_id = -1;
+    for (int i = 0; i < H2->n; i++)
+        if (H2->a[i].id > max_id)
+            max_id = H2->a[i].id;
+    if (max_id >= 0 && reserve_id(H1, max_id) != 0)
+        return NULL;
+
+    reserve_slots(H1, H1->n + H2->n);
+    for (int i = 0; i < H2->n; i++) {
+        H1->a[H1->n] = H2->a[i];
+        H1->pos[H2->a[i].id] = H1->n;
+        H1->n++;
+    }
+
+    if (H2->n > 0) {
+        for (int i = (H1->n - 2) / DARY_ARITY; i >= 0; i--)
+            sift_down(H1, i);
+    }
+
+    dary_heap_free(H2);
+    return H1;
+}
+
+/* ============================
+   FREE HEAP
+   ============================ */
+void dary_heap_free(DaryHeap *H) {
+    free(H->a);
+    free(H->pos);
+    free(H);
+}
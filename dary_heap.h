@@ -0,0 +1,46 @@
+#ifndef DARY_HEAP_H
+#define DARY_HEAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Indexed 4-ary min-heap in a flat array. Items are identified by a
+   non-negative id; pos[id] is the item's slot in the array (-1 if absent),
+   which gives decrease-key and delete by id without pointers. */
+#define DARY_ARITY 4
+
+/* pos is sized by the largest id, so larger ids are refused */
+#ifndef DARY_ID_MAX
+#define DARY_ID_MAX ((1 << 28) - 1)
+#endif
+
+typedef struct DaryEntry {
+    int key;
+    int id;
+} DaryEntry;
+
+typedef struct DaryHeap {
+    DaryEntry *a;
+    int n;
+    int cap;
+    int *pos;       /* id -> slot, -1 if not in the heap */
+    int pos_cap;
+} DaryHeap;
+
+/* Creation */
+DaryHeap* make_dary_heap();
+
+/* Operations: insert returns -1 if id is negative, above DARY_ID_MAX or
+   already present; union returns NULL and keeps both heaps if it fails */
+int dary_heap_insert(DaryHeap *H, int key, int id);
+int dary_heap_min(DaryHeap *H, int *key, int *id);
+DaryHeap* dary_heap_union(DaryHeap *H1, DaryHeap *H2);
+int dary_heap_extract_min(DaryHeap *H, int *key, int *id);
+int dary_heap_decrease_key(DaryHeap *H, int id, int k);
+int dary_heap_delete(DaryHeap *H, int id);
+int dary_heap_contains(DaryHeap *H, int id);
+
+/* Utility */
+void dary_heap_free(DaryHeap *H);
+
+#endif
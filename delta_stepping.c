@@ -0,0 +1,249 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "delta_stepping.h"
+
+/* dist in the high half, pred in the low half, so one CAS keeps them in
+   step and comparing words compares distances first */
+#define PACK(d, p)  (((unsigned long long)(unsigned int)(d) << 32) | (unsigned int)(p))
+#define DIST_OF(w)  ((int)((w) >> 32))
+#define PRED_OF(w)  ((int)(unsigned int)(w))
+
+typedef struct VertexList {
+    int *a;
+    int n;
+    int cap;
+} VertexList;
+
+/* Per-thread state. Buckets are cyclic: every pending vertex lies within
+   nbuckets of the current bucket, because no edge is heavier than that. */
+typedef struct DSWorker {
+    pthread_t thread;
+    int tid;
+    struct DSRun *run;
+    VertexList *buckets;
+    VertexList frontier;    /* this round's share of the current bucket */
+    VertexList settled;     /* vertices settled in the current bucket */
+    long long next;         /* smallest non-empty bucket seen, -1 if none */
+} DSWorker;
+
+typedef struct DSRun {
+    const Graph *G;
+    int delta;
+    int threads;
+    int nbuckets;
+    atomic_ullong *D;
+    atomic_llong *stamp;    /* bucket index + 1 at which the vertex was settled */
+    DSWorker *workers;
+    pthread_barrier_t barrier;
+    long long current;      /* bucket being settled, -1 when finished */
+    int round_total;
+} DSRun;
+
+static void list_push(VertexList *L, int v) {
+    if (L->n == L->cap) {
+        L->cap = L->cap ? L->cap * 2 : 64;
+        L->a = (int*)realloc(L->a, L->cap * sizeof(int));
+    }
+    L->a[L->n++] = v;
+}
+
+/* ============================
+   RELAXATION
+   ============================ */
+static void relax(DSWorker *w, int u, int v, long long nd) {
+    DSRun *R = w->run;
+    unsigned long long old = atomic_load_explicit(&R->D[v], memory_order_relaxed);
+    unsigned long long nw = PACK(nd, u);
+
+    while ((long long)DIST_OF(old) > nd) {
+        if (atomic_compare_exchange_weak_explicit(&R->D[v], &old, nw,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            list_push(&w->buckets[(nd / R->delta) % R->nbuckets], v);
+            return;
+        }
+    }
+}
+
+/* Relax u's light (heavy = 0) or heavy (heavy = 1) out-edges */
+static void relax_edges(DSWorker *w, int u, int heavy) {
+    DSRun *R = w->run;
+    const Graph *G = R->G;
+    long long du = DIST_OF(atomic_load_explicit(&R->D[u], memory_order_relaxed));
+
+    for (int e = G->offsets[u]; e < G->offsets[u + 1]; e++) {
+        if ((G->weights[e] > R->delta) == heavy)
+            relax(w, u, G->targets[e], du + G->weights[e]);
+    }
+}
+
+/* ============================
+   BUCKET PHASES
+   ============================ */
+
+/* Move this thread's part of the current bucket into its frontier,
+   keeping only vertices whose distance still falls in that bucket */
+static void take_current(DSWorker *w) {
+    DSRun *R = w->run;
+    VertexList *B = &w->buckets[R->current % R->nbuckets];
+
+    w->frontier.n = 0;
+    for (int i = 0; i < B->n; i++) {
+        int v = B->a[i];
+        int d = DIST_OF(atomic_load_explicit(&R->D[v], memory_order_relaxed));
+        if (d / R->delta == R->current)
+            list_push(&w->frontier, v);
+    }
+    B->n = 0;
+}
+
+/* Process global frontier positions [lo, hi) across all threads' lists */
+static void process_slice(DSWorker *w, int lo, int hi) {
+    DSRun *R = w->run;
+    int base = 0;
+
+    for (int t = 0; t < R->threads && base < hi; t++) {
+        VertexList *F = &R->workers[t].frontier;
+        int from = lo > base ? lo - base : 0;
+        int to = hi - base < F->n ? hi - base : F->n;
+
+        for (int i = from; i < to; i++) {
+            int v = F->a[i];
+            long long tag = R->current + 1;
+            if (atomic_exchange_explicit(&R->stamp[v], tag, memory_order_relaxed) != tag)
+                list_push(&w->settled, v);
+            relax_edges(w, v, 0);
+        }
+        base += F->n;
+    }
+}
+
+/* Smallest non-empty bucket after the current one, in this thread */
+static long long next_bucket(DSWorker *w) {
+    DSRun *R = w->run;
+    for (long long j = R->current + 1; j <= R->current + R->nbuckets; j++) {
+        if (w->buckets[j % R->nbuckets].n > 0)
+            return j;
+    }
+    return -1;
+}
+
+static void* worker_main(void *arg) {
+    DSWorker *w = (DSWorker*)arg;
+    DSRun *R = w->run;
+
+    while (R->current >= 0) {
+        /* light edges: repeat until no thread refills the current bucket */
+        w->settled.n = 0;
+        for (;;) {
+            take_current(w);
+            pthread_barrier_wait(&R->barrier);
+
+            int total = 0;
+            for (int t = 0; t < R->threads; t++)
+                total += R->workers[t].frontier.n;
+            if (total == 0)
+                break;
+
+            int lo = (int)((long long)total * w->tid / R->threads);
+            int hi = (int)((long long)total * (w->tid + 1) / R->threads);
+            process_slice(w, lo, hi);
+            pthread_barrier_wait(&R->barrier);
+        }
+
+        /* heavy edges of the settled vertices, in one batch */
+        for (int i = 0; i < w->settled.n; i++)
+            relax_edges(w, w->settled.a[i], 1);
+
+        w->next = next_bucket(w);
+        pthread_barrier_wait(&R->barrier);
+
+        if (w->tid == 0) {
+            long long best = -1;
+            for (int t = 0; t < R->threads; t++) {
+                long long j = R->workers[t].next;
+                if (j >= 0 && (best < 0 || j < best))
+                    best = j;
+            }
+            R->current = best;
+        }
+        pthread_barrier_wait(&R->barrier);
+    }
+    return NULL;
+}
+
+/* ============================
+   DRIVER
+   ============================ */
+int delta_stepping(const Graph *G, int source, int delta, int threads, int *dist, int *pred) {
+    if (source < 0 || source >= G->n)
+        return -1;
+    if (threads < 1)
+        threads = 1;
+
+    int n = G->n;
+    int maxw = 0;
+    for (int e = 0; e < G->m; e++) {
+        if (G->weights[e] > maxw)
+            maxw = G->weights[e];
+    }
+    if (delta <= 0) {
+        long long avg_deg = n > 0 ? ((long long)G->m + n - 1) / n : 1;
+        delta = (int)(maxw / (avg_deg > 0 ? avg_deg : 1));
+        if (delta < 1)
+            delta = 1;
+    }
+
+    DSRun R;
+    R.G = G;
+    R.delta = delta;
+    R.threads = threads;
+    R.nbuckets = maxw / delta + 2;
+    R.D = (atomic_ullong*)malloc(n * sizeof(atomic_ullong));
+    R.stamp = (atomic_llong*)malloc(n * sizeof(atomic_llong));
+    R.workers = (DSWorker*)calloc(threads, sizeof(DSWorker));
+    R.current = 0;
+    pthread_barrier_init(&R.barrier, NULL, threads);
+
+    for (int v = 0; v < n; v++) {
+        atomic_init(&R.D[v], PACK(DIJKSTRA_INF, -1));
+        atomic_init(&R.stamp[v], 0);
+    }
+
+    for (int t = 0; t < threads; t++) {
+        R.workers[t].tid = t;
+        R.workers[t].run = &R;
+        R.workers[t].buckets = (VertexList*)calloc(R.nbuckets, sizeof(VertexList));
+    }
+
+    atomic_store(&R.D[source], PACK(0, -1));
+    list_push(&R.workers[0].buckets[0], source);
+
+    for (int t = 1; t < threads; t++)
+        pthread_create(&R.workers[t].thread, NULL, worker_main, &R.workers[t]);
+    worker_main(&R.workers[0]);
+    for (int t = 1; t < threads; t++)
+        pthread_join(R.workers[t].thread, NULL);
+
+    for (int v = 0; v < n; v++) {
+        unsigned long long w = atomic_load(&R.D[v]);
+        dist[v] = DIST_OF(w);
+        if (pred) pred[v] = PRED_OF(w);
+    }
+
+    for (int t = 0; t < threads; t++) {
+        for (int b = 0; b < R.nbuckets; b++)
+            free(R.workers[t].buckets[b].a);
+        free(R.workers[t].buckets);
+        free(R.workers[t].frontier.a);
+        free(R.workers[t].settled.a);
+    }
+    pthread_barrier_destroy(&R.barrier);
+    free(R.workers);
+    free(R.stamp);
+    free(R.D);
+    return 0;
+}
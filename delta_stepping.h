@@ -0,0 +1,17 @@
+#ifndef DELTA_STEPPING_H
+#define DELTA_STEPPING_H
+
+#include "graph.h"
+#include "dijkstra.h"
+
+/* Parallel single-source shortest paths by delta-stepping, on `threads`
+   threads (the caller is one of them). Vertices are bucketed by
+   dist / delta; light edges (w <= delta) are relaxed in parallel until the
+   current bucket settles, then the bucket's heavy edges are relaxed in one
+   batch. delta <= 0 picks max weight / average out-degree.
+   dist and pred are filled as by dijkstra(): the distances are identical,
+   pred is some shortest-path predecessor (ties may resolve differently).
+   Returns 0, or -1 if source is out of range. */
+int delta_stepping(const Graph *G, int source, int delta, int threads, int *dist, int *pred);
+
+#endif
@@ -0,0 +1,363 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <math.h>
+
+#include "dijkstra.h"
+#include "fib_heap_template.h"
+
+/* A* keys are g + h, so they need a double-keyed heap */
+FIBHEAP_DEFINE(astar, double, int, FIBHEAP_LT)
+
+/* ============================
+   SINGLE-SOURCE SHORTEST PATHS
+   ============================
+   One FibNode per vertex lives in `nodes`; handle[v] points at it while v
+   is in the heap, so relaxations call fib_heap_decrease_key directly and
+   the vertex of an extracted node is just its offset in the array. */
+int dijkstra(const Graph *G, int source, int *dist, int *pred) {
+    if (source < 0 || source >= G->n)
+        return -1;
+
+    int n = G->n;
+    FibHeap *H = make_fib_heap();
+    FibNode *nodes = (FibNode*)malloc(n * sizeof(FibNode));
+    FibNode **handle = (FibNode**)malloc(n * sizeof(FibNode*));
+
+    for (int v = 0; v < n; v++) {
+        dist[v] = DIJKSTRA_INF;
+        handle[v] = NULL;
+        if (pred) pred[v] = -1;
+    }
+
+    dist[source] = 0;
+    handle[source] = &nodes[source];
+    fib_heap_insert_node(H, handle[source], 0);
+
+    while (H->min != NULL) {
+        FibNode *x = fib_heap_extract_min(H);
+        int u = (int)(x - nodes);
+        handle[u] = NULL;
+
+        int du = dist[u];
+        for (int e = G->offsets[u]; e < G->offsets[u + 1]; e++) {
+            int v = G->targets[e];
+            long long nd = (long long)du + G->weights[e];
+            if (nd >= dist[v])
+                continue;
+
+            if (dist[v] == DIJKSTRA_INF) {
+                handle[v] = &nodes[v];
+                fib_heap_insert_node(H, handle[v], (int)nd);
+            } else {
+                fib_heap_decrease_key(H, handle[v], (int)nd);
+            }
+            dist[v] = (int)nd;
+            if (pred) pred[v] = u;
+        }
+    }
+
+    free(handle);
+    free(nodes);
+    fib_heap_free(H);
+    return 0;
+}
+
+/* ============================
+   BACKEND-GENERIC VARIANT
+   ============================
+   The vertex is the item id, so handle[v] only serves decrease_key. */
+int dijkstra_with(const Graph *G, int source, int *dist, int *pred, const PQBackend *pq) {
+    if (source < 0 || source >= G->n)
+        return -1;
+
+    int n = G->n;
+    void *H = pq->create();
+    PQHandle *handle = (PQHandle*)malloc(n * sizeof(PQHandle));
+
+    for (int v = 0; v < n; v++) {
+        dist[v] = DIJKSTRA_INF;
+        handle[v] = NULL;
+        if (pred) pred[v] = -1;
+    }
+
+    dist[source] = 0;
+    handle[source] = pq->insert(H, 0, source);
+
+    int du, u;
+    while (pq->extract_min(H, &du, &u)) {
+        handle[u] = NULL;
+
+        for (int e = G->offsets[u]; e < G->offsets[u + 1]; e++) {
+            int v = G->targets[e];
+            long long nd = (long long)du + G->weights[e];
+            if (nd >= dist[v])
+                continue;
+
+            if (dist[v] == DIJKSTRA_INF)
+                handle[v] = pq->insert(H, (int)nd, v);
+            else
+                pq->decrease_key(H, handle[v], (int)nd);
+            dist[v] = (int)nd;
+            if (pred) pred[v] = u;
+        }
+    }
+
+    free(handle);
+    pq->destroy(H);
+    return 0;
+}
+
+/* ============================
+   POINT-TO-POINT: SEARCH STATE
+   ============================
+   One direction of a search: a heap with one FibNode per vertex, as in
+   dijkstra(), plus that direction's distances. dist[v] only counts when
+   stamp[v] equals the current epoch, so starting a new query is an epoch
+   bump and a heap reset rather than an O(n) clear. */
+typedef struct SearchSide {
+    const Graph *G;
+    FibHeap *H;
+    FibNode *nodes;
+    int *dist;
+    unsigned int *stamp;
+    unsigned int epoch;
+} SearchSide;
+
+struct QueryWorkspace {
+    const Graph *G;
+    const Graph *Gr;
+    SearchSide fwd;
+    SearchSide bwd;     /* unused if Gr is NULL */
+};
+
+static void side_init(SearchSide *S, const Graph *G) {
+    S->G = G;
+    S->H = make_fib_heap();
+    S->nodes = (FibNode*)malloc(G->n * sizeof(FibNode));
+    S->dist = (int*)malloc(G->n * sizeof(int));
+    S->stamp = (unsigned int*)calloc(G->n, sizeof(unsigned int));
+    S->epoch = 0;
+}
+
+static void side_free(SearchSide *S) {
+    fib_heap_reset(S->H);   /* the nodes belong to S->nodes */
+    fib_heap_free(S->H);
+    free(S->stamp);
+    free(S->dist);
+    free(S->nodes);
+}
+
+static int side_dist(const SearchSide *S, int v) {
+    return S->stamp[v] == S->epoch ? S->dist[v] : DIJKSTRA_INF;
+}
+
+static void side_set(SearchSide *S, int v, int d) {
+    S->stamp[v] = S->epoch;
+    S->dist[v] = d;
+}
+
+/* Start a new search from source */
+static void side_begin(SearchSide *S, int source) {
+    fib_heap_reset(S->H);
+    if (++S->epoch == 0) {
+        /* wrapped: clear stale stamps once every 2^32 queries */
+        for (int v = 0; v < S->G->n; v++)
+            S->stamp[v] = 0;
+        S->epoch = 1;
+    }
+
+    side_set(S, source, 0);
+    fib_heap_insert_node(S->H, &S->nodes[source], 0);
+}
+
+/* Settle the heap minimum and relax its out-edges. If `other` is given,
+   every scanned edge that reaches a vertex labelled by the other side is
+   a candidate s-t path, and *best keeps the shortest one. */
+static int side_step(SearchSide *S, SearchSide *other, long long *best, QueryStats *st) {
+    FibNode *x = fib_heap_extract_min(S->H);
+    int u = (int)(x - S->nodes);
+    int du = S->dist[u];
+    const Graph *G = S->G;
+
+    if (st) {
+        st->settled++;
+        st->scanned += G->offsets[u + 1] - G->offsets[u];
+    }
+
+    for (int e = G->offsets[u]; e < G->offsets[u + 1]; e++) {
+        int v = G->targets[e];
+        long long nd = (long long)du + G->weights[e];
+
+        if (other) {
+            int dv = side_dist(other, v);
+            if (dv != DIJKSTRA_INF && nd + dv < *best)
+                *best = nd + dv;
+        }
+
+        int old = side_dist(S, v);
+        if (nd >= old)
+            continue;
+
+        if (old == DIJKSTRA_INF)
+            fib_heap_insert_node(S->H, &S->nodes[v], (int)nd);
+        else
+            fib_heap_decrease_key(S->H, &S->nodes[v], (int)nd);
+        side_set(S, v, (int)nd);
+    }
+    return u;
+}
+
+static int query_args_ok(const Graph *G, int s, int t, QueryStats *stats) {
+    if (stats) {
+        stats->settled = 0;
+        stats->scanned = 0;
+    }
+    return s >= 0 && s < G->n && t >= 0 && t < G->n;
+}
+
+/* ============================
+   POINT-TO-POINT: WORKSPACE
+   ============================ */
+QueryWorkspace* make_query_workspace(const Graph *G, const Graph *Gr) {
+    QueryWorkspace *W = (QueryWorkspace*)malloc(sizeof(QueryWorkspace));
+    W->G = G;
+    W->Gr = Gr;
+    side_init(&W->fwd, G);
+    if (Gr)
+        side_init(&W->bwd, Gr);
+    return W;
+}
+
+void query_workspace_free(QueryWorkspace *W) {
+    side_free(&W->fwd);
+    if (W->Gr)
+        side_free(&W->bwd);
+    free(W);
+}
+
+int query_workspace_to(QueryWorkspace *W, int s, int t, QueryStats *stats) {
+    if (!query_args_ok(W->G, s, t, stats))
+        return -1;
+
+    SearchSide *F = &W->fwd;
+    side_begin(F, s);
+
+    while (F->H->min != NULL) {
+        if (side_step(F, NULL, NULL, stats) == t)
+            return F->dist[t];
+    }
+    return DIJKSTRA_INF;
+}
+
+int query_workspace_bidir(QueryWorkspace *W, int s, int t, QueryStats *stats) {
+    if (W->Gr == NULL || !query_args_ok(W->G, s, t, stats))
+        return -1;
+    if (s == t)
+        return 0;
+
+    SearchSide *F = &W->fwd, *B = &W->bwd;
+    side_begin(F, s);
+    side_begin(B, t);
+
+    long long best = DIJKSTRA_INF;
+    while (F->H->min != NULL && B->H->min != NULL) {
+        if ((long long)F->H->min->key + B->H->min->key >= best)
+            break;
+
+        if (F->H->n <= B->H->n)
+            side_step(F, B, &best, stats);
+        else
+            side_step(B, F, &best, stats);
+    }
+    return (int)best;
+}
+
+/* ============================
+   POINT-TO-POINT: ONE-SHOT
+   ============================ */
+int dijkstra_to(const Graph *G, int s, int t, QueryStats *stats) {
+    if (!query_args_ok(G, s, t, stats))
+        return -1;
+
+    QueryWorkspace *W = make_query_workspace(G, NULL);
+    int d = query_workspace_to(W, s, t, stats);
+    query_workspace_free(W);
+    return d;
+}
+
+int dijkstra_bidir(const Graph *G, const Graph *Gr, int s, int t, QueryStats *stats) {
+    if (!query_args_ok(G, s, t, stats))
+        return -1;
+
+    QueryWorkspace *W = make_query_workspace(G, Gr);
+    int d = query_workspace_bidir(W, s, t, stats);
+    query_workspace_free(W);
+    return d;
+}
+
+/* ============================
+   POINT-TO-POINT: A*
+   ============================ */
+double astar_euclidean(int v, int target, void *ctx) {
+    const AStarCoords *c = (const AStarCoords*)ctx;
+    double dx = c->x[v] - c->x[target];
+    double dy = c->y[v] - c->y[target];
+    return c->scale * sqrt(dx * dx + dy * dy);
+}
+
+int dijkstra_astar(const Graph *G, int s, int t, AStarHeuristic h, void *ctx, QueryStats *stats) {
+    if (!query_args_ok(G, s, t, stats))
+        return -1;
+    if (h == NULL)
+        h = astar_euclidean;
+
+    int n = G->n;
+    astar_heap *H = astar_create();
+    astar_node **handle = (astar_node**)malloc(n * sizeof(astar_node*));
+    int *g = (int*)malloc(n * sizeof(int));
+
+    for (int v = 0; v < n; v++) {
+        g[v] = DIJKSTRA_INF;
+        handle[v] = NULL;
+    }
+
+    g[s] = 0;
+    handle[s] = astar_insert(H, h(s, t, ctx), s);
+
+    int result = DIJKSTRA_INF;
+    astar_node *x;
+    while ((x = astar_extract_min(H)) != NULL) {
+        int u = x->payload;
+        astar_release(H, x);
+        handle[u] = NULL;
+
+        if (stats) {
+            stats->settled++;
+            stats->scanned += G->offsets[u + 1] - G->offsets[u];
+        }
+        if (u == t) {
+            result = g[t];
+            break;
+        }
+
+        for (int e = G->offsets[u]; e < G->offsets[u + 1]; e++) {
+            int v = G->targets[e];
+            long long nd = (long long)g[u] + G->weights[e];
+            if (nd >= g[v])
+                continue;
+
+            g[v] = (int)nd;
+            double f = nd + h(v, t, ctx);
+            if (handle[v] != NULL)
+                astar_decrease_key(H, handle[v], f);
+            else
+                handle[v] = astar_insert(H, f, v);     /* new, or reopened */
+        }
+    }
+
+    free(g);
+    free(handle);
+    astar_free(H);
+    return result;
+}
@@ -0,0 +1,66 @@
+#ifndef DIJKSTRA_H
+#define DIJKSTRA_H
+
+#include <limits.h>
+
+#include "graph.h"
+#include "modified_fib_heap.h"
+#include "pq_backend.h"
+
+/* distance of a vertex not reachable from the source */
+#define DIJKSTRA_INF INT_MAX
+
+/* Single-source shortest paths from `source`.
+   dist[v] receives the distance (DIJKSTRA_INF if unreachable) and
+   pred[v] the previous vertex on a shortest path (-1 for none).
+   pred may be NULL. Returns 0, or -1 if source is out of range. */
+int dijkstra(const Graph *G, int source, int *dist, int *pred);
+
+/* Same, on any priority-queue backend (pass PQ_BACKEND_DEFAULT or one
+   from pq_backend_by_name). */
+int dijkstra_with(const Graph *G, int source, int *dist, int *pred, const PQBackend *pq);
+
+/* ============================
+   POINT-TO-POINT QUERIES
+   ============================
+   Each returns the s-t distance, DIJKSTRA_INF if t is unreachable, or -1
+   if s or t is out of range. stats may be NULL. */
+typedef struct QueryStats {
+    int settled;    /* vertices extracted from a heap (both heaps if bidirectional) */
+    int scanned;    /* edges examined */
+} QueryStats;
+
+/* Plain Dijkstra that stops once t is settled */
+int dijkstra_to(const Graph *G, int s, int t, QueryStats *stats);
+
+/* Forward search from s on G and backward search from t on Gr =
+   graph_transpose(G), always expanding the smaller heap. Stops when the
+   two heap minima add up to at least the best s-t path seen. */
+int dijkstra_bidir(const Graph *G, const Graph *Gr, int s, int t, QueryStats *stats);
+
+/* Reusable state for many queries on one graph: a heap and node array
+   per direction, and epoch-stamped distances, so each query costs only
+   what it touches. Gr may be NULL if only query_workspace_to is used.
+   A workspace must not be shared between threads. */
+typedef struct QueryWorkspace QueryWorkspace;
+
+QueryWorkspace* make_query_workspace(const Graph *G, const Graph *Gr);
+int query_workspace_to(QueryWorkspace *W, int s, int t, QueryStats *stats);
+int query_workspace_bidir(QueryWorkspace *W, int s, int t, QueryStats *stats);
+void query_workspace_free(QueryWorkspace *W);
+
+/* A*: h(v, t, ctx) must never overestimate the v-t distance. Vertices
+   are reopened if their distance improves, so h need not be consistent.
+   With h == NULL, ctx is an AStarCoords and astar_euclidean is used. */
+typedef double (*AStarHeuristic)(int v, int target, void *ctx);
+
+typedef struct AStarCoords {
+    const double *x;
+    const double *y;
+    double scale;   /* lower bound on weight per unit of distance */
+} AStarCoords;
+
+double astar_euclidean(int v, int target, void *ctx);
+int dijkstra_astar(const Graph *G, int s, int t, AStarHeuristic h, void *ctx, QueryStats *stats);
+
+#endif
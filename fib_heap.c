@@ -197,13 +197,14 @@ static void fib_heap_cut(FibHeap *H, FibNode *x, FibNode *y) {
 
 static void fib_heap_cascading_cut(FibHeap *H, FibNode *y) {
     FibNode *z = y->parent;
-    if (z != NULL) {
-        if (y->mark == 0)
+    while (z != NULL) {
+        if (y->mark == 0) {
             y->mark = 1;
-        else {
-            fib_heap_cut(H, y, z);
-            fib_heap_cascading_cut(H, z);
+            break;
         }
+        fib_heap_cut(H, y, z);
+        y = z;
+        z = y->parent;
     }
 }
 
@@ -247,17 +248,28 @@ void fib_heap_print(FibHeap *H) {
 }
 
 
+/* Free a whole forest without recursion: a node's child ring is spliced
+   into its own ring before the node is freed, so one loop reaches all. */
 static void free_node(FibNode *node) {
     if (node == NULL) return;
-    FibNode *start = node;
     FibNode *curr = node;
-    do {
-        FibNode *next = curr->right;
-        if (curr->child != NULL)
-            free_node(curr->child);
+    while (curr != NULL) {
+        FibNode *child = curr->child;
+        if (child != NULL) {
+            FibNode *child_last = child->left;
+            child_last->right = curr->right;
+            curr->right->left = child_last;
+            curr->right = child;
+            child->left = curr;
+        }
+        FibNode *next = (curr->right == curr) ? NULL : curr->right;
+        if (next != NULL) {
+            curr->left->right = next;
+            next->left = curr->left;
+        }
         free(curr);
         curr = next;
-    } while (curr != start);
+    }
 }
 
 void fib_heap_free(FibHeap *H) {
@@ -269,6 +281,7 @@ void fib_heap_free(FibHeap *H) {
 
 
 
+#ifndef FIB_HEAP_NO_MAIN
 int main() {
     FibHeap *H = make_fib_heap();
     FibNode *node;
@@ -380,4 +393,5 @@ int main() {
         }
     }
     return 0;
-}
\ No newline at end of file
+}
+#endif /* FIB_HEAP_NO_MAIN */
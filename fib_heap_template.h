@@ -0,0 +1,280 @@
+#ifndef FIB_HEAP_TEMPLATE_H
+#define FIB_HEAP_TEMPLATE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* ============================
+   TYPE-GENERIC FIBONACCI HEAP
+   ============================
+   FIBHEAP_DEFINE(prefix, key_t, payload_t, less) emits a Fibonacci heap
+   specialised for one key type and one payload type. `less(a, b)` is a
+   macro or inline function, so every comparison in link and consolidate
+   is inlined. Nodes carry the payload directly, so no side table is
+   needed to get from a node back to (say) its vertex.
+
+     FIBHEAP_DEFINE(fibd, double, int, FIBHEAP_LT)
+
+     fibd_heap *H = fibd_create();
+     fibd_node *x = fibd_insert(H, 2.5, vertex);
+     fibd_decrease_key(H, x, 1.0);
+     fibd_node *m = fibd_extract_min(H);   // m->key, m->payload
+     fibd_release(H, m);
+     fibd_free(H);
+
+   This is a frozen subset of modified_fib_heap.c, kept to what A* in
+   dijkstra.c and multiqueue.c need: insert, min, extract-min and
+   decrease-key, over a per-heap slab pool with a freelist and a reused
+   degree table. There is no delete, union, id index, stats or snapshot.
+   New features and fixes go into modified_fib_heap.c; port a fix here
+   only if it touches one of these operations. */
+
+#define FIBHEAP_LT(a, b) ((a) < (b))
+#define FIBHEAP_GT(a, b) ((a) > (b))
+
+#define FIBHEAP_SLAB_MIN 64
+#define FIBHEAP_SLAB_MAX 65536
+
+#define FIBHEAP_DEFINE(P, K, V, LESS)                                          \
+                                                                               \
+typedef struct P##_node {                                                      \
+    K key;                                                                     \
+    V payload;                                                                 \
+    int degree;                                                                \
+    int mark;                                                                  \
+    struct P##_node *parent;                                                   \
+    struct P##_node *child;                                                    \
+    struct P##_node *left;                                                     \
+    struct P##_node *right;                                                    \
+} P##_node;                                                                    \
+                                                                               \
+typedef struct P##_slab {                                                      \
+    struct P##_slab *next;                                                     \
+    int capacity;                                                              \
+    P##_node nodes[];                                                          \
+} P##_slab;                                                                    \
+                                                                               \
+typedef struct P##_heap {                                                      \
+    P##_node *min;                                                             \
+    int n;                                                                     \
+    P##_slab *slabs;                                                           \
+    int used;                                                                  \
+    P##_node *free_list;                                                       \
+    P##_node **degree_table;                                                   \
+    int degree_cap;                                                            \
+} P##_heap;                                                                    \
+                                                                               \
+static inline P##_heap* P##_create(void) {                                     \
+    return (P##_heap*)calloc(1, sizeof(P##_heap));                             \
+}                                                                              \
+                                                                               \
+static inline P##_node* P##_alloc_node(P##_heap *H) {                          \
+    P##_node *x = H->free_list;                                                \
+    if (x != NULL) {                                                           \
+        H->free_list = x->right;                                               \
+        return x;                                                              \
+    }                                                                          \
+    if (H->slabs == NULL || H->used == H->slabs->capacity) {                   \
+        int cap = H->slabs ? H->slabs->capacity * 2 : FIBHEAP_SLAB_MIN;        \
+        if (cap > FIBHEAP_SLAB_MAX)                                            \
+            cap = FIBHEAP_SLAB_MAX;                                            \
+        P##_slab *s = (P##_slab*)malloc(sizeof(P##_slab)                       \
+                                        + (size_t)cap * sizeof(P##_node));     \
+        s->capacity = cap;                                                     \
+        s->next = H->slabs;                                                    \
+        H->slabs = s;                                                          \
+        H->used = 0;                                                           \
+    }                                                                          \
+    return &H->slabs->nodes[H->used++];                                        \
+}                                                                              \
+                                                                               \
+/* give back a node returned by extract_min */                                 \
+static inline void P##_release(P##_heap *H, P##_node *x) {                     \
+    x->right = H->free_list;                                                   \
+    H->free_list = x;                                                          \
+}                                                                              \
+                                                                               \
+static inline void P##_add_root(P##_heap *H, P##_node *x) {                    \
+    if (H->min == NULL) {                                                      \
+        H->min = x;                                                            \
+        x->left = x->right = x;                                                \
+    } else {                                                                   \
+        x->right = H->min->right;                                              \
+        x->left = H->min;                                                      \
+        H->min->right->left = x;                                               \
+        H->min->right = x;                                                     \
+        if (LESS(x->key, H->min->key))                                         \
+            H->min = x;                                                        \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+static inline P##_node* P##_insert(P##_heap *H, K key, V payload) {            \
+    P##_node *x = P##_alloc_node(H);                                           \
+    x->key = key;                                                              \
+    x->payload = payload;                                                      \
+    x->degree = 0;                                                             \
+    x->mark = 0;                                                               \
+    x->parent = NULL;                                                          \
+    x->child = NULL;                                                           \
+    P##_add_root(H, x);                                                        \
+    H->n++;                                                                    \
+    return x;                                                                  \
+}                                                                              \
+                                                                               \
+static inline P##_node* P##_min(P##_heap *H) {                                 \
+    return H->min;                                                             \
+}                                                                              \
+                                                                               \
+/* make y a child of x; y's root-list links are rebuilt by the caller */       \
+static inline void P##_link(P##_node *y, P##_node *x) {                        \
+    y->parent = x;                                                             \
+    y->mark = 0;                                                               \
+    if (x->child == NULL) {                                                    \
+        x->child = y;                                                          \
+        y->left = y->right = y;                                                \
+    } else {                                                                   \
+        y->right = x->child->right;                                            \
+        y->left = x->child;                                                    \
+        x->child->right->left = y;                                             \
+        x->child->right = y;                                                   \
+    }                                                                          \
+    x->degree++;                                                               \
+}                                                                              \
+                                                                               \
+/* Single pass: the root ring is opened into a list and walked with the        \
+   next pointer saved, then rebuilt from the degree table. */                  \
+static inline void P##_consolidate(P##_heap *H) {                              \
+    int bits = 0;                                                              \
+    for (int t = H->n; t > 0; t >>= 1)                                         \
+        bits++;                                                                \
+    int D = (3 * bits) / 2 + 2;                                                \
+    if (D > H->degree_cap) {                                                   \
+        int cap = H->degree_cap ? H->degree_cap : 16;                          \
+        while (cap < D)                                                        \
+            cap *= 2;                                                          \
+        H->degree_table = (P##_node**)realloc(H->degree_table,                 \
+                                              cap * sizeof(P##_node*));        \
+        for (int i = H->degree_cap; i < cap; i++)                              \
+            H->degree_table[i] = NULL;                                         \
+        H->degree_cap = cap;                                                   \
+    }                                                                          \
+    P##_node **A = H->degree_table;                                            \
+                                                                               \
+    P##_node *w = H->min;                                                      \
+    w->left->right = NULL;                                                     \
+    while (w != NULL) {                                                        \
+        P##_node *next = w->right;                                             \
+        P##_node *x = w;                                                       \
+        int d = x->degree;                                                     \
+        while (A[d] != NULL) {                                                 \
+            P##_node *y = A[d];                                                \
+            if (LESS(y->key, x->key)) {                                        \
+                P##_node *tmp = x;                                             \
+                x = y;                                                         \
+                y = tmp;                                                       \
+            }                                                                  \
+            P##_link(y, x);                                                    \
+            A[d] = NULL;                                                       \
+            d++;                                                               \
+        }                                                                      \
+        A[d] = x;                                                              \
+        w = next;                                                              \
+    }                                                                          \
+                                                                               \
+    H->min = NULL;                                                             \
+    for (int i = 0; i < D; i++) {                                              \
+        if (A[i] != NULL) {                                                    \
+            P##_add_root(H, A[i]);                                             \
+            A[i] = NULL;                                                       \
+        }                                                                      \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+static inline P##_node* P##_extract_min(P##_heap *H) {                         \
+    P##_node *z = H->min;                                                      \
+    if (z == NULL)                                                             \
+        return NULL;                                                           \
+                                                                               \
+    /* splice the child ring into the root ring in O(1) */                     \
+    P##_node *c = z->child;                                                    \
+    if (c != NULL) {                                                           \
+        P##_node *w = c;                                                       \
+        do {                                                                   \
+            w->parent = NULL;                                                  \
+            w = w->right;                                                      \
+        } while (w != c);                                                      \
+        P##_node *c_last = c->left;                                            \
+        c_last->right = z->right;                                              \
+        z->right->left = c_last;                                               \
+        z->right = c;                                                          \
+        c->left = z;                                                           \
+        z->child = NULL;                                                       \
+    }                                                                          \
+                                                                               \
+    z->left->right = z->right;                                                 \
+    z->right->left = z->left;                                                  \
+    if (z == z->right)                                                         \
+        H->min = NULL;                                                         \
+    else {                                                                     \
+        H->min = z->right;                                                     \
+        P##_consolidate(H);                                                    \
+    }                                                                          \
+    H->n--;                                                                    \
+    return z;                                                                  \
+}                                                                              \
+                                                                               \
+static inline void P##_cut(P##_heap *H, P##_node *x, P##_node *y) {            \
+    if (x->right == x)                                                         \
+        y->child = NULL;                                                       \
+    else {                                                                     \
+        if (y->child == x)                                                     \
+            y->child = x->right;                                               \
+        x->left->right = x->right;                                             \
+        x->right->left = x->left;                                              \
+    }                                                                          \
+    y->degree--;                                                               \
+    x->parent = NULL;                                                          \
+    x->mark = 0;                                                               \
+    P##_add_root(H, x);                                                        \
+}                                                                              \
+                                                                               \
+static inline void P##_cascading_cut(P##_heap *H, P##_node *y) {               \
+    P##_node *z = y->parent;                                                   \
+    while (z != NULL) {                                                        \
+        if (y->mark == 0) {                                                    \
+            y->mark = 1;                                                       \
+            return;                                                            \
+        }                                                                      \
+        P##_cut(H, y, z);                                                      \
+        y = z;                                                                 \
+        z = y->parent;                                                         \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+/* Returns 0, or -1 if k is larger than the current key */                     \
+static inline int P##_decrease_key(P##_heap *H, P##_node *x, K k) {            \
+    if (LESS(x->key, k))                                                       \
+        return -1;                                                             \
+    x->key = k;                                                                \
+    P##_node *y = x->parent;                                                   \
+    if (y != NULL && LESS(x->key, y->key)) {                                   \
+        P##_cut(H, x, y);                                                      \
+        P##_cascading_cut(H, y);                                               \
+    }                                                                          \
+    if (LESS(x->key, H->min->key))                                             \
+        H->min = x;                                                            \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+static inline void P##_free(P##_heap *H) {                                     \
+    P##_slab *s = H->slabs;                                                    \
+    while (s != NULL) {                                                        \
+        P##_slab *next = s->next;                                              \
+        free(s);                                                               \
+        s = next;                                                              \
+    }                                                                          \
+    free(H->degree_table);                                                     \
+    free(H);                                                                   \
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef FIB_SIMD_H
+#define FIB_SIMD_H
+
+/* Key-scan kernels over flat int arrays. The kernel is picked at compile
+   time: AVX2 with -mavx2, SSE4.1 with -msse4.1, SSE2 on any other x86-64
+   build, and a scalar loop elsewhere or with -DFIB_HEAP_NO_SIMD. */
+#if !defined(FIB_HEAP_NO_SIMD) && defined(__AVX2__)
+#define FIB_SIMD_AVX2
+#include <immintrin.h>
+#elif !defined(FIB_HEAP_NO_SIMD) && defined(__SSE4_1__)
+#define FIB_SIMD_SSE41
+#include <smmintrin.h>
+#elif !defined(FIB_HEAP_NO_SIMD) && defined(__SSE2__)
+#define FIB_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+static inline const char* fib_simd_kernel(void) {
+#if defined(FIB_SIMD_AVX2)
+    return "avx2";
+#elif defined(FIB_SIMD_SSE41)
+    return "sse4.1";
+#elif defined(FIB_SIMD_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+static inline int fib_simd_argmin_scalar(const int *keys, int n) {
+    int best = 0;
+    for (int i = 1; i < n; i++)
+        if (keys[i] < keys[best])
+            best = i;
+    return best;
+}
+
+#if defined(FIB_SIMD_SSE41) || defined(FIB_SIMD_SSE2)
+static inline __m128i fib_simd_min4(__m128i a, __m128i b) {
+#ifdef FIB_SIMD_SSE41
+    return _mm_min_epi32(a, b);
+#else
+    __m128i gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+#endif
+}
+#endif
+
+/* Index of the first smallest key, or -1 if n <= 0. One vector pass finds
+   the minimum value, a second finds its first position, so ties resolve
+   exactly like the scalar loop. */
+static inline int fib_simd_argmin(const int *keys, int n) {
+    if (n <= 0)
+        return -1;
+
+#if defined(FIB_SIMD_AVX2)
+    if (n < 16)
+        return fib_simd_argmin_scalar(keys, n);
+
+    __m256i m0 = _mm256_loadu_si256((const __m256i*)keys);
+    __m256i m1 = _mm256_loadu_si256((const __m256i*)(keys + 8));
+    int i = 16;
+    for (; i + 16 <= n; i += 16) {
+        m0 = _mm256_min_epi32(m0, _mm256_loadu_si256((const __m256i*)(keys + i)));
+        m1 = _mm256_min_epi32(m1, _mm256_loadu_si256((const __m256i*)(keys + i + 8)));
+    }
+    m0 = _mm256_min_epi32(m0, m1);
+    __m128i m = _mm_min_epi32(_mm256_castsi256_si128(m0), _mm256_extracti128_si256(m0, 1));
+    m = _mm_min_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm_min_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+    int best = _mm_cvtsi128_si32(m);
+    for (; i < n; i++)
+        if (keys[i] < best)
+            best = keys[i];
+
+    __m256i target = _mm256_set1_epi32(best);
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(keys + i)), target);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+#elif defined(FIB_SIMD_SSE41) || defined(FIB_SIMD_SSE2)
+    if (n < 8)
+        return fib_simd_argmin_scalar(keys, n);
+
+    __m128i m0 = _mm_loadu_si128((const __m128i*)keys);
+    __m128i m1 = _mm_loadu_si128((const __m128i*)(keys + 4));
+    int i = 8;
+    for (; i + 8 <= n; i += 8) {
+        m0 = fib_simd_min4(m0, _mm_loadu_si128((const __m128i*)(keys + i)));
+        m1 = fib_simd_min4(m1, _mm_loadu_si128((const __m128i*)(keys + i + 4)));
+    }
+    __m128i m = fib_simd_min4(m0, m1);
+    m = fib_simd_min4(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = fib_simd_min4(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+    int best = _mm_cvtsi128_si32(m);
+    for (; i < n; i++)
+        if (keys[i] < best)
+            best = keys[i];
+
+    __m128i target = _mm_set1_epi32(best);
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(keys + i)), target);
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+#else
+    return fib_simd_argmin_scalar(keys, n);
+#endif
+
+#if defined(FIB_SIMD_AVX2) || defined(FIB_SIMD_SSE41) || defined(FIB_SIMD_SSE2)
+    for (; i < n; i++)
+        if (keys[i] == best)
+            return i;
+    return -1;
+#endif
+}
+
+#endif
@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "graph.h"
+
+/* ============================
+   BUILD CSR FROM EDGE LIST
+   ============================ */
+Graph* make_graph(int n, int m, const int *src, const int *dst, const int *w) {
+    for (int i = 0; i < m; i++) {
+        if (src[i] < 0 || src[i] >= n || dst[i] < 0 || dst[i] >= n || w[i] < 0)
+            return NULL;
+    }
+
+    Graph *G = (Graph*)malloc(sizeof(Graph));
+    G->n = n;
+    G->m = m;
+    G->offsets = (int*)calloc(n + 1, sizeof(int));
+    G->targets = (int*)malloc(m * sizeof(int));
+    G->weights = (int*)malloc(m * sizeof(int));
+    G->mapping = NULL;
+    G->mapping_len = 0;
+    G->unmap = NULL;
+
+    /* count out-degrees, then prefix sum into offsets */
+    for (int i = 0; i < m; i++)
+        G->offsets[src[i] + 1]++;
+    for (int u = 0; u < n; u++)
+        G->offsets[u + 1] += G->offsets[u];
+
+    /* scatter edges, using a cursor per vertex */
+    int *pos = (int*)malloc(n * sizeof(int));
+    for (int u = 0; u < n; u++)
+        pos[u] = G->offsets[u];
+
+    for (int i = 0; i < m; i++) {
+        int e = pos[src[i]]++;
+        G->targets[e] = dst[i];
+        G->weights[e] = w[i];
+    }
+
+    free(pos);
+    return G;
+}
+
+/* ============================
+   TRANSPOSE
+   ============================ */
+Graph* graph_transpose(const Graph *G) {
+    Graph *T = (Graph*)malloc(sizeof(Graph));
+    T->n = G->n;
+    T->m = G->m;
+    T->offsets = (int*)calloc(G->n + 1, sizeof(int));
+    T->targets = (int*)malloc(G->m * sizeof(int));
+    T->weights = (int*)malloc(G->m * sizeof(int));
+    T->mapping = NULL;
+    T->mapping_len = 0;
+    T->unmap = NULL;
+
+    for (int e = 0; e < G->m; e++)
+        T->offsets[G->targets[e] + 1]++;
+    for (int v = 0; v < G->n; v++)
+        T->offsets[v + 1] += T->offsets[v];
+
+    int *pos = (int*)malloc(G->n * sizeof(int));
+    for (int v = 0; v < G->n; v++)
+        pos[v] = T->offsets[v];
+
+    for (int u = 0; u < G->n; u++) {
+        for (int e = G->offsets[u]; e < G->offsets[u + 1]; e++) {
+            int f = pos[G->targets[e]]++;
+            T->targets[f] = u;
+            T->weights[f] = G->weights[e];
+        }
+    }
+
+    free(pos);
+    return T;
+}
+
+/* ============================
+   FREE GRAPH
+   ============================ */
+void graph_free(Graph *G) {
+    if (!G) return;
+    if (G->mapping) {
+        G->unmap(G->mapping, G->mapping_len);
+        free(G);
+        return;
+    }
+    free(G->offsets);
+    free(G->targets);
+    free(G->weights);
+    free(G);
+}
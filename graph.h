@@ -0,0 +1,33 @@
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Directed graph in CSR (compressed sparse row) form.
+   Out-edges of u are targets[offsets[u] .. offsets[u+1]-1]. */
+typedef struct Graph {
+    int n;          /* number of vertices */
+    int m;          /* number of edges */
+    int *offsets;   /* n + 1 entries */
+    int *targets;   /* m entries */
+    int *weights;   /* m entries, non-negative */
+
+    /* set by graph_map_binary: the arrays point into this block and
+       graph_free hands it to unmap instead of freeing them */
+    void *mapping;
+    size_t mapping_len;
+    void (*unmap)(void *mapping, size_t len);
+} Graph;
+
+/* Creation: build from an edge list (src[i] -> dst[i], weight w[i]).
+   Returns NULL on an out-of-range endpoint or a negative weight. */
+Graph* make_graph(int n, int m, const int *src, const int *dst, const int *w);
+
+/* Reverse every edge, keeping weights (for backward searches) */
+Graph* graph_transpose(const Graph *G);
+
+/* Utility */
+void graph_free(Graph *G);
+
+#endif
@@ -0,0 +1,450 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+
+/* graph_map_binary maps the file where POSIX mmap is available and reads
+   it into one malloc block everywhere else (or with -DGRAPH_IO_NO_MMAP) */
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+#if !defined(GRAPH_IO_NO_MMAP) && defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+#define GRAPH_IO_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/* the unlocked getc is POSIX; plain getc elsewhere */
+#if !defined(_POSIX_VERSION)
+#define getc_unlocked getc
+#endif
+
+#include "graph_io.h"
+
+#define CSR_MAGIC "FIBCSR1"
+#define READ_BUFFER (1 << 20)
+
+typedef struct CsrHeader {
+    char magic[8];
+    int64_t n;
+    int64_t m;
+    int64_t reserved;
+} CsrHeader;
+
+/* ============================
+   TEXT SCANNING
+   ============================ */
+
+/* Skip blanks on the current line; returns the next char without consuming it */
+static int peek_token(FILE *f) {
+    int c;
+    do {
+        c = getc_unlocked(f);
+    } while (c == ' ' || c == '\t' || c == '\r');
+    if (c != EOF)
+        ungetc(c, f);
+    return c;
+}
+
+static void skip_line(FILE *f) {
+    int c;
+    do {
+        c = getc_unlocked(f);
+    } while (c != '\n' && c != EOF);
+}
+
+/* Read one non-negative integer from the current line; 0 if none */
+static int read_int(FILE *f, long long *out) {
+    int c = peek_token(f);
+    if (c < '0' || c > '9')
+        return 0;
+
+    long long v = 0;
+    while ((c = getc_unlocked(f)) >= '0' && c <= '9') {
+        v = v * 10 + (c - '0');
+        if (v > 0x7FFFFFFF)
+            return 0;
+    }
+    if (c != EOF)
+        ungetc(c, f);
+    *out = v;
+    return 1;
+}
+
+/* Like read_int, but the number must end at a blank, a newline or EOF */
+static int read_field(FILE *f, long long *out) {
+    if (!read_int(f, out))
+        return 0;
+
+    int c = getc_unlocked(f);
+    if (c != EOF)
+        ungetc(c, f);
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == EOF;
+}
+
+/* ============================
+   CSR ASSEMBLY
+   ============================ */
+/* Graph with zeroed offsets for n vertices and no edge arrays yet, or
+   NULL if an allocation fails */
+static Graph* alloc_csr(int n) {
+    Graph *G = (Graph*)malloc(sizeof(Graph));
+    if (!G)
+        return NULL;
+    G->n = n;
+    G->m = 0;
+    G->offsets = (int*)calloc((size_t)n + 1, sizeof(int));
+    G->targets = NULL;
+    G->weights = NULL;
+    G->mapping = NULL;
+    G->mapping_len = 0;
+    G->unmap = NULL;
+    if (!G->offsets) {
+        free(G);
+        return NULL;
+    }
+    return G;
+}
+
+/* Size the edge arrays once pass 1 has counted m; -1 if out of memory */
+static int alloc_edges(Graph *G, int m) {
+    size_t bytes = (m > 0 ? (size_t)m : 1) * sizeof(int);
+    G->m = m;
+    G->targets = (int*)malloc(bytes);
+    G->weights = (int*)malloc(bytes);
+    return G->targets && G->weights ? 0 : -1;
+}
+
+/* offsets[u + 1] holds the out-degree of u: turn it into start offsets
+   and return a per-vertex write cursor, or NULL if out of memory */
+static int* counts_to_cursors(Graph *G) {
+    for (int u = 0; u < G->n; u++)
+        G->offsets[u + 1] += G->offsets[u];
+
+    size_t bytes = ((size_t)G->n + 1) * sizeof(int);
+    int *pos = (int*)malloc(bytes);
+    if (pos)
+        memcpy(pos, G->offsets, bytes);
+    return pos;
+}
+
+static FILE* open_text(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (f)
+        setvbuf(f, NULL, _IOFBF, READ_BUFFER);
+    return f;
+}
+
+/* ============================
+   DIMACS IMPORT
+   ============================ */
+
+/* Parse the next "a u v w" line (0-based result); 0 at end of file, -1 on error */
+static int next_arc(FILE *f, int n, int *u, int *v, int *w) {
+    for (;;) {
+        int c = peek_token(f);
+        if (c == EOF)
+            return 0;
+
+        getc_unlocked(f);
+        if (c == 'a') {
+            long long a, b, wt;
+            if (!read_field(f, &a) || !read_field(f, &b) || !read_field(f, &wt))
+                return -1;
+            if (a < 1 || a > n || b < 1 || b > n)
+                return -1;
+            skip_line(f);
+            *u = (int)a - 1;
+            *v = (int)b - 1;
+            *w = (int)wt;
+            return 1;
+        }
+        if (c != '\n')
+            skip_line(f);
+    }
+}
+
+Graph* graph_load_dimacs(const char *path) {
+    FILE *f = open_text(path);
+    if (!f)
+        return NULL;
+
+    /* the problem line gives n and m */
+    long long n = -1, m = -1;
+    for (;;) {
+        int c = peek_token(f);
+        if (c == EOF)
+            break;
+        getc_unlocked(f);
+        if (c == 'p') {
+            while ((c = peek_token(f)) >= 'a' && c <= 'z')
+                getc_unlocked(f);
+            if (!read_field(f, &n) || !read_field(f, &m))
+                n = -1;
+            skip_line(f);
+            break;
+        }
+        if (c != '\n')
+            skip_line(f);
+    }
+
+    /* read_int already caps m at INT_MAX; m only has to match the arcs */
+    long long data = ftell(f);
+    Graph *G = NULL;
+    if (n >= 0 && n <= GRAPH_IO_MAX_N && data >= 0)
+        G = alloc_csr((int)n);
+    if (!G) {
+        fclose(f);
+        return NULL;
+    }
+    int u, v, w, rc;
+    long long count = 0;
+
+    /* pass 1: out-degrees */
+    while ((rc = next_arc(f, G->n, &u, &v, &w)) == 1) {
+        if (++count > m)
+            break;
+        G->offsets[u + 1]++;
+    }
+    int *pos = NULL;
+    if (rc < 0 || count != m || fseek(f, data, SEEK_SET) != 0
+            || alloc_edges(G, (int)m) != 0 || (pos = counts_to_cursors(G)) == NULL) {
+        graph_free(G);
+        fclose(f);
+        return NULL;
+    }
+
+    /* pass 2: scatter */
+    while (next_arc(f, G->n, &u, &v, &w) == 1) {
+        int e = pos[u]++;
+        G->targets[e] = v;
+        G->weights[e] = w;
+    }
+
+    free(pos);
+    fclose(f);
+    return G;
+}
+
+/* ============================
+   EDGE LIST IMPORT
+   ============================ */
+
+/* Parse the next "u v [w]" line; 0 at end of file, -1 on error */
+static int next_edge(FILE *f, int *u, int *v, int *w) {
+    for (;;) {
+        int c = peek_token(f);
+        if (c == EOF)
+            return 0;
+        if (c == '\n' || c == '#' || c == '%') {
+            skip_line(f);
+            continue;
+        }
+
+        /* the weight defaults to 1 only if the line ends after v */
+        long long a, b, wt = 1;
+        if (!read_field(f, &a) || !read_field(f, &b))
+            return -1;
+        c = peek_token(f);
+        if (c != '\n' && c != EOF && !read_field(f, &wt))
+            return -1;
+        skip_line(f);
+        *u = (int)a;
+        *v = (int)b;
+        *w = (int)wt;
+        return 1;
+    }
+}
+
+Graph* graph_load_edgelist(const char *path) {
+    FILE *f = open_text(path);
+    if (!f)
+        return NULL;
+
+    /* pass 1: out-degrees into a growing table, and the largest id */
+    int *deg = NULL;
+    size_t cap = 0;
+    int n = 0, m = 0, u, v, w, rc;
+    while ((rc = next_edge(f, &u, &v, &w)) == 1) {
+        int hi = u > v ? u : v;
+        if (hi >= GRAPH_IO_MAX_N || m == INT_MAX) {
+            rc = -1;
+            break;
+        }
+        if ((size_t)hi >= cap) {
+            size_t ncap = cap ? cap : 1024;
+            while (ncap <= (size_t)hi)
+                ncap *= 2;
+            int *grown = (int*)realloc(deg, ncap * sizeof(int));
+            if (!grown) {
+                rc = -1;
+                break;
+            }
+            memset(grown + cap, 0, (ncap - cap) * sizeof(int));
+            deg = grown;
+            cap = ncap;
+        }
+        if (hi + 1 > n)
+            n = hi + 1;
+        deg[u]++;
+        m++;
+    }
+    Graph *G = NULL;
+    if (rc == 0 && fseek(f, 0, SEEK_SET) == 0)
+        G = alloc_csr(n);
+    if (!G) {
+        free(deg);
+        fclose(f);
+        return NULL;
+    }
+    for (int i = 0; i < n; i++)
+        G->offsets[i + 1] = deg[i];
+    free(deg);
+
+    int *pos = NULL;
+    if (alloc_edges(G, m) != 0 || (pos = counts_to_cursors(G)) == NULL) {
+        graph_free(G);
+        fclose(f);
+        return NULL;
+    }
+
+    /* pass 2: scatter */
+    while (next_edge(f, &u, &v, &w) == 1) {
+        int e = pos[u]++;
+        G->targets[e] = v;
+        G->weights[e] = w;
+    }
+
+    free(pos);
+    fclose(f);
+    return G;
+}
+
+/* ============================
+   BINARY CSR
+   ============================ */
+int graph_save_binary(const Graph *G, const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return -1;
+
+    CsrHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, CSR_MAGIC, sizeof(CSR_MAGIC));
+    h.n = G->n;
+    h.m = G->m;
+
+    int ok = fwrite(&h, sizeof(h), 1, f) == 1
+          && fwrite(G->offsets, sizeof(int), G->n + 1, f) == (size_t)G->n + 1
+          && fwrite(G->targets, sizeof(int), G->m, f) == (size_t)G->m
+          && fwrite(G->weights, sizeof(int), G->m, f) == (size_t)G->m;
+
+    if (fclose(f) != 0)
+        ok = 0;
+    return ok ? 0 : -1;
+}
+
+/* One pass over the arrays: offsets run from 0 to m without decreasing,
+   every target is a vertex and every weight is non-negative */
+static int csr_arrays_ok(const int32_t *offsets, int n, int m) {
+    if (offsets[0] != 0 || offsets[n] != m)
+        return 0;
+    for (int u = 0; u < n; u++)
+        if (offsets[u] > offsets[u + 1])
+            return 0;
+
+    const int32_t *targets = offsets + n + 1;
+    const int32_t *weights = targets + m;
+    for (int e = 0; e < m; e++)
+        if (targets[e] < 0 || targets[e] >= n || weights[e] < 0)
+            return 0;
+    return 1;
+}
+
+/* map_file returns the whole file read-only, or NULL; unmap_file
+   releases it and is what graph_free calls for a mapped graph */
+#ifdef GRAPH_IO_MMAP
+static void unmap_file(void *map, size_t len) {
+    munmap(map, len);
+}
+
+static void* map_file(const char *path, size_t *len) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return NULL;
+    }
+
+    *len = (size_t)st.st_size;
+    void *map = mmap(NULL, *len, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    return map == MAP_FAILED ? NULL : map;
+}
+#else
+static void unmap_file(void *map, size_t len) {
+    (void)len;
+    free(map);
+}
+
+static void* map_file(const char *path, size_t *len) {
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return NULL;
+
+    long size = -1;
+    if (fseek(f, 0, SEEK_END) == 0)
+        size = ftell(f);
+    void *buf = NULL;
+    if (size > 0 && fseek(f, 0, SEEK_SET) == 0) {
+        buf = malloc((size_t)size);
+        if (buf && fread(buf, 1, (size_t)size, f) != (size_t)size) {
+            free(buf);
+            buf = NULL;
+        }
+    }
+
+    fclose(f);
+    *len = (size_t)size;
+    return buf;
+}
+#endif
+
+Graph* graph_map_binary(const char *path) {
+    size_t len;
+    void *map = map_file(path, &len);
+    if (!map)
+        return NULL;
+    if (len < sizeof(CsrHeader)) {
+        unmap_file(map, len);
+        return NULL;
+    }
+
+    const CsrHeader *h = (const CsrHeader*)map;
+    int32_t *base = (int32_t*)((char*)map + sizeof(CsrHeader));
+    int valid = memcmp(h->magic, CSR_MAGIC, sizeof(CSR_MAGIC)) == 0
+             && h->n >= 0 && h->n < 0x7FFFFFFF && h->m >= 0 && h->m <= 0x7FFFFFFF
+             && len == sizeof(CsrHeader) + (size_t)(h->n + 1 + 2 * h->m) * sizeof(int32_t);
+    if (valid && !csr_arrays_ok(base, (int)h->n, (int)h->m))
+        valid = 0;
+    if (!valid) {
+        unmap_file(map, len);
+        return NULL;
+    }
+
+    Graph *G = (Graph*)malloc(sizeof(Graph));
+    G->n = (int)h->n;
+    G->m = (int)h->m;
+    G->offsets = base;
+    G->targets = base + G->n + 1;
+    G->weights = G->targets + G->m;
+    G->mapping = map;
+    G->mapping_len = len;
+    G->unmap = unmap_file;
+    return G;
+}
@@ -0,0 +1,42 @@
+#ifndef GRAPH_IO_H
+#define GRAPH_IO_H
+
+#include "graph.h"
+
+/* Text importers. Both read the file twice (count out-degrees, then
+   fill the CSR arrays), so memory stays at the size of the final graph
+   and the input must be a seekable file. Return NULL on a malformed line,
+   an out-of-range vertex, a negative weight, an allocation failure or an
+   I/O error. */
+
+/* Most vertices an imported graph may have. A file that declares or uses
+   more is refused before anything is sized from it. */
+#ifndef GRAPH_IO_MAX_N
+#define GRAPH_IO_MAX_N (1 << 28)
+#endif
+
+/* DIMACS shortest-path format: "p sp n m", "a u v w" (1-based), "c ...".
+   Every field is a whole non-negative int. n must be at most
+   GRAPH_IO_MAX_N and m must match the arc count; the edge arrays are only
+   sized once the arcs have been counted. */
+Graph* graph_load_dimacs(const char *path);
+
+/* One edge per line: "u v [w]" (0-based, weight 1 if the line ends
+   after v). Ids must be below GRAPH_IO_MAX_N. Any third token must be a
+   non-negative int; later tokens are ignored. Lines starting with '#' or
+   '%' are comments. n is the largest id + 1. */
+Graph* graph_load_edgelist(const char *path);
+
+/* Binary CSR: a 32-byte header (magic "FIBCSR1", n, m) followed by
+   offsets, targets and weights as native-endian int32 arrays. */
+int graph_save_binary(const Graph *G, const char *path);
+
+/* Map a binary CSR file read-only and point the Graph at it: no parsing
+   or copying, and processes mapping the same file share its page-cache
+   pages. Without POSIX mmap (or with -DGRAPH_IO_NO_MMAP) the file is read
+   into one block instead. graph_free releases either. Returns NULL if the
+   file is not a valid graph: the header, non-decreasing offsets, targets
+   below n and non-negative weights are all checked in one O(n + m) pass. */
+Graph* graph_map_binary(const char *path);
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef LAT_HIST_H
+#define LAT_HIST_H
+
+#include <stdio.h>
+#include <string.h>
+
+/* Log-linear latency histogram: 16 linear sub-buckets per power of two,
+   so any percentile is within ~6% of the true value. Fixed size, no
+   allocation, cheap enough to update on every operation. */
+#define LAT_HIST_SUB 16
+#define LAT_HIST_BUCKETS (LAT_HIST_SUB * 60)
+
+typedef struct LatHist {
+    unsigned long long count;
+    unsigned long long max;
+    unsigned long long total;
+    unsigned long long buckets[LAT_HIST_BUCKETS];
+} LatHist;
+
+static inline void lat_hist_reset(LatHist *h) {
+    memset(h, 0, sizeof(*h));
+}
+
+static inline int lat_hist_bucket(unsigned long long v) {
+    if (v < LAT_HIST_SUB)
+        return (int)v;
+
+    int e = 63 - __builtin_clzll(v);                    /* e >= 4 */
+    int sub = (int)((v >> (e - 4)) & (LAT_HIST_SUB - 1));
+    int b = (e - 3) * LAT_HIST_SUB + sub;
+    return b < LAT_HIST_BUCKETS ? b : LAT_HIST_BUCKETS - 1;
+}
+
+/* smallest value that falls into bucket b */
+static inline unsigned long long lat_hist_bucket_low(int b) {
+    if (b < LAT_HIST_SUB)
+        return (unsigned long long)b;
+
+    int e = b / LAT_HIST_SUB + 3;
+    int sub = b % LAT_HIST_SUB;
+    return ((unsigned long long)(LAT_HIST_SUB + sub)) << (e - 4);
+}
+
+static inline void lat_hist_record(LatHist *h, unsigned long long v) {
+    h->buckets[lat_hist_bucket(v)]++;
+    h->count++;
+    h->total += v;
+    if (v > h->max)
+        h->max = v;
+}
+
+static inline void lat_hist_merge(LatHist *dst, const LatHist *src) {
+    for (int i = 0; i < LAT_HIST_BUCKETS; i++)
+        dst->buckets[i] += src->buckets[i];
+    dst->count += src->count;
+    dst->total += src->total;
+    if (src->max > dst->max)
+        dst->max = src->max;
+}
+
+/* value at percentile p (0..100), 0 for an empty histogram */
+static inline unsigned long long lat_hist_percentile(const LatHist *h, double p) {
+    if (h->count == 0)
+        return 0;
+
+    unsigned long long rank = (unsigned long long)(p / 100.0 * (h->count - 1)) + 1;
+    unsigned long long seen = 0;
+    for (int i = 0; i < LAT_HIST_BUCKETS; i++) {
+        seen += h->buckets[i];
+        if (seen >= rank)
+            return lat_hist_bucket_low(i);
+    }
+    return h->max;
+}
+
+#endif
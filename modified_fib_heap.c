@@ -1,9 +1,42 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <limits.h>
-#include <math.h>
+#include <string.h>
+#include <stdint.h>
+
+/* fib_heap_load maps snapshots where POSIX mmap is available and reads
+   them with stdio everywhere else (or with -DFIB_HEAP_NO_MMAP) */
+#if !defined(FIB_HEAP_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#include <unistd.h>
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+#define FIB_SNAP_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#endif
 
 #include "modified_fib_heap.h"
+#include "fib_simd.h"
+
+#ifdef FIB_HEAP_STATS
+#include <time.h>
+
+static unsigned long long stats_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+#define STAT_INC(H, field) ((H)->stats.field++)
+#define STAT_TIMER_START(t) unsigned long long t = stats_now_ns()
+#define STAT_TIMER_STOP(H, op, t) \
+    lat_hist_record(&(H)->stats.latency[op], stats_now_ns() - (t))
+#else
+#define STAT_INC(H, field) ((void)0)
+#define STAT_TIMER_START(t) ((void)0)
+#define STAT_TIMER_STOP(H, op, t) ((void)0)
+#endif
 
 /* ============================
    BASIC CREATION FUNCTIONS
@@ -12,6 +45,21 @@ FibHeap* make_fib_heap() {
     FibHeap *H = (FibHeap*)malloc(sizeof(FibHeap));
     H->min = NULL;
     H->n = 0;
+    H->n_dead = 0;
+#ifndef FIB_HEAP_NO_POOL
+    H->pool.slabs = NULL;
+    H->pool.free_list = NULL;
+    H->pool.free_tail = NULL;
+    H->pool.used = 0;
+#endif
+    H->index = NULL;
+    H->index_cap = 0;
+    H->degree_table = NULL;
+    H->degree_cap = 0;
+    H->roots = NULL;
+    H->roots_cap = 0;
+    H->root_keys = NULL;
+    fib_heap_stats_reset(H);
     return H;
 }
 
@@ -20,14 +68,167 @@ FibNode* make_fib_node(int key) {
     x->key = key;
     x->degree = 0;
     x->mark = 0;
+    x->dead = 0;
+    x->id = -1;
+    x->parent = NULL;
+    x->child = NULL;
+    x->left = x;
+    x->right = x;
+    return x;
+}
+
+/* ============================
+   NODE POOL
+   ============================ */
+#ifndef FIB_HEAP_NO_POOL
+
+#define FIB_SLAB_MIN_NODES 64
+#define FIB_SLAB_MAX_NODES 65536
+
+/* Take a node from the freelist, or carve one from the newest slab.
+   Slabs double in size up to FIB_SLAB_MAX_NODES so small heaps stay small. */
+static FibNode* pool_alloc(FibNodePool *P) {
+    FibNode *x = P->free_list;
+    if (x != NULL) {
+        P->free_list = x->right;
+        if (P->free_list == NULL)
+            P->free_tail = NULL;
+        return x;
+    }
+
+    if (P->slabs == NULL || P->used == P->slabs->capacity) {
+        int cap = FIB_SLAB_MIN_NODES;
+        if (P->slabs != NULL) {
+            cap = P->slabs->capacity * 2;
+            if (cap > FIB_SLAB_MAX_NODES)
+                cap = FIB_SLAB_MAX_NODES;
+        }
+        FibSlab *s = (FibSlab*)malloc(sizeof(FibSlab) + (size_t)cap * sizeof(FibNode));
+        s->capacity = cap;
+        s->next = P->slabs;
+        P->slabs = s;
+        P->used = 0;
+    }
+
+    return &P->slabs->nodes[P->used++];
+}
+
+/* Carve n consecutive nodes. A run that doesn't fit in the current slab
+   gets a fresh slab; one larger than a normal slab gets a dedicated slab
+   linked behind the current one, so the current slab keeps filling. */
+static FibNode* pool_alloc_run(FibNodePool *P, int n) {
+    if (P->slabs != NULL && P->slabs->capacity - P->used >= n) {
+        FibNode *run = &P->slabs->nodes[P->used];
+        P->used += n;
+        return run;
+    }
+
+    int cap = FIB_SLAB_MIN_NODES;
+    if (P->slabs != NULL) {
+        cap = P->slabs->capacity * 2;
+        if (cap > FIB_SLAB_MAX_NODES)
+            cap = FIB_SLAB_MAX_NODES;
+    }
+
+    if (n > cap && P->slabs != NULL) {
+        FibSlab *s = (FibSlab*)malloc(sizeof(FibSlab) + (size_t)n * sizeof(FibNode));
+        s->capacity = n;
+        s->next = P->slabs->next;
+        P->slabs->next = s;
+        return s->nodes;
+    }
+
+    if (n > cap)
+        cap = n;
+    FibSlab *s = (FibSlab*)malloc(sizeof(FibSlab) + (size_t)cap * sizeof(FibNode));
+    s->capacity = cap;
+    s->next = P->slabs;
+    P->slabs = s;
+    P->used = n;
+    return s->nodes;
+}
+
+static void pool_release(FibNodePool *P, FibNode *x) {
+    x->right = P->free_list;
+    if (P->free_list == NULL)
+        P->free_tail = x;
+    P->free_list = x;
+}
+
+/* Move every slab and free node of src into dst. Slabs keep their
+   addresses, so nodes already linked into a heap stay valid. */
+static void pool_merge(FibNodePool *dst, FibNodePool *src) {
+    if (src->slabs != NULL) {
+        if (dst->slabs == NULL) {
+            dst->slabs = src->slabs;
+            dst->used = src->used;
+        } else {
+            /* keep dst's partially used slab at the head */
+            FibSlab *tail = src->slabs;
+            while (tail->next != NULL)
+                tail = tail->next;
+            tail->next = dst->slabs->next;
+            dst->slabs->next = src->slabs;
+        }
+    }
+
+    if (src->free_list != NULL) {
+        src->free_tail->right = dst->free_list;
+        if (dst->free_list == NULL)
+            dst->free_tail = src->free_tail;
+        dst->free_list = src->free_list;
+    }
+
+    src->slabs = NULL;
+    src->free_list = src->free_tail = NULL;
+    src->used = 0;
+}
+
+static void pool_destroy(FibNodePool *P) {
+    FibSlab *s = P->slabs;
+    while (s != NULL) {
+        FibSlab *next = s->next;
+        free(s);
+        s = next;
+    }
+    P->slabs = NULL;
+    P->free_list = P->free_tail = NULL;
+    P->used = 0;
+}
+
+#endif /* FIB_HEAP_NO_POOL */
+
+/* Allocate a node for heap H (pooled unless FIB_HEAP_NO_POOL) */
+static FibNode* fib_heap_alloc_node(FibHeap *H, int key) {
+#ifndef FIB_HEAP_NO_POOL
+    FibNode *x = pool_alloc(&H->pool);
+    x->key = key;
+    x->degree = 0;
+    x->mark = 0;
+    x->dead = 0;
+    x->id = -1;
     x->parent = NULL;
     x->child = NULL;
     x->left = x;
     x->right = x;
     return x;
+#else
+    (void)H;
+    return make_fib_node(key);
+#endif
+}
+
+void fib_heap_release_node(FibHeap *H, FibNode *x) {
+#ifndef FIB_HEAP_NO_POOL
+    pool_release(&H->pool, x);
+#else
+    (void)H;
+    free(x);
+#endif
 }
 
-/* Insert into root list */
+/* Insert into root list. A dead node never becomes the min unless the
+   list was empty; consolidate then picks a live one. */
 static void insert_into_root(FibHeap *H, FibNode *x) {
     if (H->min == NULL) {
         H->min = x;
@@ -37,63 +238,403 @@ static void insert_into_root(FibHeap *H, FibNode *x) {
         x->left = H->min;
         H->min->right->left = x;
         H->min->right = x;
-        if (x->key < H->min->key)
+        if (!x->dead && x->key < H->min->key)
             H->min = x;
     }
 }
 
 FibNode* fib_heap_insert(FibHeap *H, int key) {
-    FibNode *x = make_fib_node(key);
+    STAT_TIMER_START(t0);
+    FibNode *x = fib_heap_alloc_node(H, key);
     insert_into_root(H, x);
     H->n++;
+    STAT_TIMER_STOP(H, FIB_OP_INSERT, t0);
     return x;
 }
 
+/* Insert a caller-owned node (e.g. one slot of a per-vertex array).
+   The heap never frees such nodes, so don't fib_heap_delete them. */
+void fib_heap_insert_node(FibHeap *H, FibNode *x, int key) {
+    x->key = key;
+    x->degree = 0;
+    x->mark = 0;
+    x->dead = 0;
+    x->id = -1;
+    x->parent = NULL;
+    x->child = NULL;
+    insert_into_root(H, x);
+    H->n++;
+}
+
+/* ============================
+   BATCH INSERT
+   ============================
+   Nodes are taken as one contiguous run from the pool (one malloc each
+   with FIB_HEAP_NO_POOL), pre-linked into a ring, spliced into the root
+   list in one step, and the new min found with a vector scan of keys. */
+void fib_heap_insert_batch(FibHeap *H, const int *keys, int n, FibNode **out_handles) {
+    if (n <= 0)
+        return;
+
+#ifndef FIB_HEAP_NO_POOL
+    FibNode *run = pool_alloc_run(&H->pool, n);
+#define BATCH_NODE(i) (&run[i])
+#else
+    FibNode **run = (FibNode**)malloc(n * sizeof(FibNode*));
+    for (int i = 0; i < n; i++)
+        run[i] = make_fib_node(keys[i]);
+#define BATCH_NODE(i) (run[i])
+#endif
+
+    for (int i = 0; i < n; i++) {
+        FibNode *x = BATCH_NODE(i);
+        x->key = keys[i];
+        x->degree = 0;
+        x->mark = 0;
+        x->dead = 0;
+        x->id = -1;
+        x->parent = NULL;
+        x->child = NULL;
+        x->left = BATCH_NODE(i == 0 ? n - 1 : i - 1);
+        x->right = BATCH_NODE(i == n - 1 ? 0 : i + 1);
+        if (out_handles)
+            out_handles[i] = x;
+    }
+
+    FibNode *first = BATCH_NODE(0);
+    FibNode *last = BATCH_NODE(n - 1);
+    FibNode *batch_min = BATCH_NODE(fib_simd_argmin(keys, n));
+#undef BATCH_NODE
+#ifdef FIB_HEAP_NO_POOL
+    free(run);
+#endif
+
+    if (H->min == NULL) {
+        H->min = batch_min;
+    } else {
+        last->right = H->min->right;
+        H->min->right->left = last;
+        H->min->right = first;
+        first->left = H->min;
+        if (batch_min->key < H->min->key)
+            H->min = batch_min;
+    }
+
+    H->n += n;
+}
+
 FibNode* fib_heap_min(FibHeap *H) {
     return H->min;
 }
 
 /* ============================
-   UNION OF TWO HEAPS
+   ID INDEX
    ============================ */
-FibHeap* fib_heap_union(FibHeap *H1, FibHeap *H2) {
-    if (H1->min == NULL) return H2;
-    if (H2->min == NULL) return H1;
+/* Grow the table to cover id. Returns -1 if id is outside
+   [0, FIB_ID_MAX] or the table cannot grow. */
+static int index_reserve(FibHeap *H, int id) {
+    if (id < 0 || id > FIB_ID_MAX)
+        return -1;
+    if (id < H->index_cap)
+        return 0;
+
+    size_t cap = H->index_cap ? (size_t)H->index_cap : 64;
+    while (cap <= (size_t)id)
+        cap *= 2;
+
+    FibNode **t = (FibNode**)realloc(H->index, cap * sizeof(FibNode*));
+    if (t == NULL)
+        return -1;
+    H->index = t;
+    for (size_t i = (size_t)H->index_cap; i < cap; i++)
+        H->index[i] = NULL;
+    H->index_cap = (int)cap;
+    return 0;
+}
 
-    FibHeap *H = make_fib_heap();
+/* Drop an extracted or deleted node from the index */
+static void index_remove(FibHeap *H, FibNode *x) {
+    if (x->id >= 0)
+        H->index[x->id] = NULL;
+}
+
+/* Move src's id table into dst; the larger table is kept and the
+   smaller one copied into it. Ids must be unique across both heaps. */
+static void index_merge(FibHeap *dst, FibHeap *src) {
+    if (src->index == NULL)
+        return;
+
+    if (dst->index_cap < src->index_cap) {
+        FibNode **t = dst->index;
+        int cap = dst->index_cap;
+        dst->index = src->index;
+        dst->index_cap = src->index_cap;
+        src->index = t;
+        src->index_cap = cap;
+    }
+
+    for (int i = 0; i < src->index_cap; i++) {
+        if (src->index[i] != NULL)
+            dst->index[i] = src->index[i];
+    }
+
+    free(src->index);
+    src->index = NULL;
+    src->index_cap = 0;
+}
+
+/* Returns NULL if id is outside [0, FIB_ID_MAX] or already present */
+FibNode* fib_heap_insert_with_id(FibHeap *H, int key, int id) {
+    if (fib_heap_find_by_id(H, id) != NULL || index_reserve(H, id) != 0)
+        return NULL;
+
+    FibNode *x = fib_heap_insert(H, key);
+    x->id = id;
+    H->index[id] = x;
+    return x;
+}
+
+FibNode* fib_heap_find_by_id(FibHeap *H, int id) {
+    if (id < 0 || id >= H->index_cap)
+        return NULL;
+    return H->index[id];
+}
+
+/* Returns 0 on success, -1 if the id is unknown or k is larger */
+int fib_heap_decrease_key_by_id(FibHeap *H, int id, int k) {
+    FibNode *x = fib_heap_find_by_id(H, id);
+    if (x == NULL)
+        return -1;
+
+    return fib_heap_decrease_key(H, x, k);
+}
+
+/* Returns 0 on success, -1 if the id is unknown */
+int fib_heap_update_key_by_id(FibHeap *H, int id, int k) {
+    FibNode *x = fib_heap_find_by_id(H, id);
+    if (x == NULL)
+        return -1;
+
+    return fib_heap_update_key(H, x, k);
+}
 
-    /* concatenate root lists */
-    FibNode *a = H1->min;
-    FibNode *b = H2->min;
+/* Returns 0 on success, -1 if the id is unknown */
+int fib_heap_delete_by_id(FibHeap *H, int id) {
+    FibNode *x = fib_heap_find_by_id(H, id);
+    if (x == NULL)
+        return -1;
 
-    a->right->left = b->left;
-    b->left->right = a->right;
+    fib_heap_delete(H, x);
+    return 0;
+}
+
+/* ============================
+   CONSOLIDATE SCRATCH BUFFERS
+   ============================ */
+/* Upper bound on any root degree: log_phi(n) < 1.5 * bits(n) */
+static int max_degree(int n) {
+    int bits = 0;
+    while (n > 0) {
+        bits++;
+        n >>= 1;
+    }
+    return (3 * bits) / 2 + 2;
+}
+
+/* Grow the persistent degree table and root snapshot geometrically.
+   The degree table is all NULL between consolidations. root_keys is the
+   key shadow for the rebuild and is sized with the degree table. */
+static void scratch_reserve_degree(FibHeap *H, int D) {
+    if (D <= H->degree_cap)
+        return;
+
+    int cap = H->degree_cap ? H->degree_cap : 16;
+    while (cap < D)
+        cap *= 2;
+
+    H->degree_table = (FibNode**)realloc(H->degree_table, cap * sizeof(FibNode*));
+    H->root_keys = (int*)realloc(H->root_keys, cap * sizeof(int));
+    for (int i = H->degree_cap; i < cap; i++)
+        H->degree_table[i] = NULL;
+    H->degree_cap = cap;
+}
+
+static void scratch_grow_roots(FibHeap *H) {
+    H->roots_cap = H->roots_cap ? H->roots_cap * 2 : 64;
+    H->roots = (FibNode**)realloc(H->roots, H->roots_cap * sizeof(FibNode*));
+}
+
+static void scratch_free(FibHeap *H) {
+    free(H->degree_table);
+    free(H->roots);
+    free(H->root_keys);
+    H->degree_table = NULL;
+    H->roots = NULL;
+    H->root_keys = NULL;
+    H->degree_cap = H->roots_cap = 0;
+}
+
+/* ============================
+   STATS
+   ============================ */
+#ifdef FIB_HEAP_STATS
+static const char *stats_op_names[FIB_OP_COUNT] = {
+    "insert", "extract_min", "decrease_key", "increase_key", "delete", "union"
+};
+
+static void stats_merge(FibHeap *dst, FibHeap *src) {
+    dst->stats.links += src->stats.links;
+    dst->stats.cuts += src->stats.cuts;
+    dst->stats.cascade_cuts += src->stats.cascade_cuts;
+    if (src->stats.max_cascade_depth > dst->stats.max_cascade_depth)
+        dst->stats.max_cascade_depth = src->stats.max_cascade_depth;
+    dst->stats.consolidations += src->stats.consolidations;
+    lat_hist_merge(&dst->stats.root_len, &src->stats.root_len);
+    for (int i = 0; i < FIB_OP_COUNT; i++)
+        lat_hist_merge(&dst->stats.latency[i], &src->stats.latency[i]);
+}
+
+static void stats_dump_hist(FILE *out, const char *name, const LatHist *h) {
+    if (h->count == 0)
+        return;
+    fprintf(out, "  %-14s %12llu %10.1f %8llu %8llu %8llu %8llu %10llu\n",
+            name, h->count, (double)h->total / h->count,
+            lat_hist_percentile(h, 50.0), lat_hist_percentile(h, 90.0),
+            lat_hist_percentile(h, 99.0), lat_hist_percentile(h, 99.9), h->max);
+}
 
-    a->right = b;
-    b->left = a;
+void fib_heap_stats_reset(FibHeap *H) {
+    memset(&H->stats, 0, sizeof(H->stats));
+}
+
+void fib_heap_stats_dump(FibHeap *H, FILE *out) {
+    const FibHeapStats *S = &H->stats;
+
+    fprintf(out, "links: %llu  cuts: %llu  cascading cuts: %llu  max cascade depth: %d\n",
+            S->links, S->cuts, S->cascade_cuts, S->max_cascade_depth);
+    fprintf(out, "consolidations: %llu\n", S->consolidations);
+    fprintf(out, "  %-14s %12s %10s %8s %8s %8s %8s %10s\n",
+            "", "count", "mean", "p50", "p90", "p99", "p99.9", "max");
+    stats_dump_hist(out, "root list len", &S->root_len);
+    for (int i = 0; i < FIB_OP_COUNT; i++)
+        stats_dump_hist(out, stats_op_names[i], &S->latency[i]);
+}
+#else
+static void stats_merge(FibHeap *dst, FibHeap *src) {
+    (void)dst;
+    (void)src;
+}
+
+void fib_heap_stats_reset(FibHeap *H) {
+    (void)H;
+}
 
-    /* pick new min */
-    H->min = (H1->min->key < H2->min->key) ? H1->min : H2->min;
-    H->n = H1->n + H2->n;
+void fib_heap_stats_dump(FibHeap *H, FILE *out) {
+    (void)H;
+    fprintf(out, "stats not compiled in (build with -DFIB_HEAP_STATS)\n");
+}
+#endif
 
-    free(H1);
-    free(H2);
+/* ============================
+   MELD / UNION
+   ============================
+   Meld splices H2's root list into H1's and hands over H2's slabs, id
+   table and stats without allocating. H2 is left empty but valid, so it
+   can be refilled or freed. Nodes extracted from H2 but not yet released
+   must be released to H1 afterwards, since their slab now belongs to H1. */
+
+/* Move H2's roots and resources into H1; the caller fixes H1->min */
+static void meld_into(FibHeap *H1, FibHeap *H2) {
+    if (H2->min != NULL) {
+        if (H1->min == NULL) {
+            H1->min = H2->min;
+        } else {
+            FibNode *a = H1->min;
+            FibNode *b = H2->min;
+
+            a->right->left = b->left;
+            b->left->right = a->right;
+
+            a->right = b;
+            b->left = a;
+        }
+    }
+    H1->n += H2->n;
+    H1->n_dead += H2->n_dead;
+
+#ifndef FIB_HEAP_NO_POOL
+    pool_merge(&H1->pool, &H2->pool);
+#endif
+    index_merge(H1, H2);
+    stats_merge(H1, H2);
+#ifdef FIB_HEAP_STATS
+    memset(&H2->stats, 0, sizeof(H2->stats));
+#endif
+
+    H2->min = NULL;
+    H2->n = 0;
+    H2->n_dead = 0;
+}
 
+void fib_heap_meld(FibHeap *H1, FibHeap *H2) {
+    if (H1 == H2)
+        return;
+
+    STAT_TIMER_START(t0);
+    FibNode *m1 = H1->min;
+    FibNode *m2 = H2->min;
+
+    meld_into(H1, H2);
+    if (m1 != NULL && m2 != NULL && m2->key < m1->key)
+        H1->min = m2;
+
+    STAT_TIMER_STOP(H1, FIB_OP_UNION, t0);
+}
+
+/* Meld heaps[1..k-1] into heaps[0]: every root list is spliced in turn
+   and the new min picked in the same pass. NULL entries are skipped.
+   Returns heaps[0]. */
+FibHeap* fib_heap_meld_many(FibHeap **heaps, int k) {
+    if (k <= 0 || heaps[0] == NULL)
+        return NULL;
+
+    FibHeap *H = heaps[0];
+    STAT_TIMER_START(t0);
+
+    FibNode *best = H->min;
+    for (int i = 1; i < k; i++) {
+        FibHeap *S = heaps[i];
+        if (S == NULL || S == H)
+            continue;
+
+        FibNode *m = S->min;
+        meld_into(H, S);
+        if (m != NULL && (best == NULL || m->key < best->key))
+            best = m;
+    }
+    H->min = best;
+
+    STAT_TIMER_STOP(H, FIB_OP_UNION, t0);
     return H;
 }
 
+/* Meld H2 into H1 and free H2. Returns H1. */
+FibHeap* fib_heap_union(FibHeap *H1, FibHeap *H2) {
+    fib_heap_meld(H1, H2);
+    if (H2 != H1)
+        fib_heap_free(H2);
+    return H1;
+}
+
 /* ============================
    LINK TWO TREES
    ============================ */
 static void fib_heap_link(FibHeap *H, FibNode *y, FibNode *x) {
-
-    /* remove y from root list */
-    y->left->right = y->right;
-    y->right->left = y->left;
-
-    /* make y child of x */
+    /* y's root-list links are rebuilt by consolidate, and may point at a
+       purged node, so y is not unlinked here */
     y->parent = x;
     y->mark = 0;
+    STAT_INC(H, links);
 
     if (x->child == NULL) {
         x->child = y;
@@ -110,33 +651,58 @@ static void fib_heap_link(FibHeap *H, FibNode *y, FibNode *x) {
 
 /* ============================
    CONSOLIDATE
-   ============================ */
+   ============================
+   Dead roots are purged on the way: their children join the snapshot
+   and are consolidated like any other root. */
+static int drop_dead_root(FibHeap *H, FibNode *x, int root_count) {
+    FibNode *c = x->child;
+    if (c != NULL) {
+        FibNode *w = c;
+        do {
+            if (root_count == H->roots_cap)
+                scratch_grow_roots(H);
+            w->parent = NULL;
+            w->mark = 0;
+            H->roots[root_count++] = w;
+            w = w->right;
+        } while (w != c);
+    }
+
+    H->n_dead--;
+    fib_heap_release_node(H, x);
+    return root_count;
+}
+
 static void fib_heap_consolidate(FibHeap *H) {
 
-    int D = (int)(log2(H->n)) + 10;
-    FibNode **A = calloc(D, sizeof(FibNode*));
+    /* dead nodes still count towards subtree sizes */
+    int D = max_degree(H->n + H->n_dead);
+    scratch_reserve_degree(H, D);
+    FibNode **A = H->degree_table;
 
+    /* snapshot the root list in a single pass */
     FibNode *start = H->min;
-    FibNode *w = H->min;
-
-    /* collect root list nodes first */
+    FibNode *w = start;
     int root_count = 0;
     do {
-        root_count++;
+        if (root_count == H->roots_cap)
+            scratch_grow_roots(H);
+        H->roots[root_count++] = w;
         w = w->right;
     } while (w != start);
 
-    FibNode **rootList = malloc(root_count * sizeof(FibNode*));
-
-    w = start;
-    for (int i = 0; i < root_count; i++) {
-        rootList[i] = w;
-        w = w->right;
-    }
+#ifdef FIB_HEAP_STATS
+    H->stats.consolidations++;
+    lat_hist_record(&H->stats.root_len, root_count);
+#endif
 
-    /* consolidate */
+    /* consolidate; the snapshot may grow while dead roots are dropped */
     for (int i = 0; i < root_count; i++) {
-        FibNode *x = rootList[i];
+        FibNode *x = H->roots[i];
+        if (x->dead) {
+            root_count = drop_dead_root(H, x, root_count);
+            continue;
+        }
         int d = x->degree;
 
         while (A[d] != NULL) {
@@ -153,28 +719,36 @@ static void fib_heap_consolidate(FibHeap *H) {
         A[d] = x;
     }
 
-    free(rootList);
-
-    /* rebuild root list */
-    H->min = NULL;
+    /* rebuild: compact the survivors and their keys (leaving the degree
+       table empty for next time), ring them in order, and take the min
+       with one vector scan of the key shadow */
+    FibNode **R = H->roots;
+    int *K = H->root_keys;
+    int r = 0;
     for (int i = 0; i < D; i++) {
         if (A[i] != NULL) {
-            A[i]->left = A[i]->right = A[i];
-            if (H->min == NULL) {
-                H->min = A[i];
-            } else {
-                insert_into_root(H, A[i]);
-            }
+            R[r] = A[i];
+            K[r] = A[i]->key;
+            r++;
+            A[i] = NULL;
         }
     }
 
-    free(A);
+    if (r == 0) {
+        H->min = NULL;
+        return;
+    }
+    for (int i = 0; i < r; i++) {
+        R[i]->left = R[i == 0 ? r - 1 : i - 1];
+        R[i]->right = R[i == r - 1 ? 0 : i + 1];
+    }
+    H->min = R[fib_simd_argmin(K, r)];
 }
 
 /* ============================
    EXTRACT MINIMUM
    ============================ */
-FibNode* fib_heap_extract_min(FibHeap *H) {
+static FibNode* extract_min(FibHeap *H) {
     FibNode *z = H->min;
 
     if (z != NULL) {
@@ -202,12 +776,228 @@ FibNode* fib_heap_extract_min(FibHeap *H) {
             fib_heap_consolidate(H);
         }
 
+        index_remove(H, z);
         H->n--;
     }
 
     return z;
 }
 
+FibNode* fib_heap_extract_min(FibHeap *H) {
+    STAT_TIMER_START(t0);
+    FibNode *z = extract_min(H);
+    STAT_TIMER_STOP(H, FIB_OP_EXTRACT_MIN, t0);
+    return z;
+}
+
+/* ============================
+   NODE FRONTIER
+   ============================
+   Binary min-heap of node pointers ordered by key. Batch extraction walks
+   the heap-ordered forest through it: pop the smallest node, push its
+   children. */
+typedef struct NodeFrontier {
+    FibNode **a;
+    int n;
+    int cap;
+} NodeFrontier;
+
+static void frontier_grow(NodeFrontier *F) {
+    F->cap = F->cap ? F->cap * 2 : 64;
+    F->a = (FibNode**)realloc(F->a, F->cap * sizeof(FibNode*));
+}
+
+static void frontier_push(NodeFrontier *F, FibNode *x) {
+    if (F->n == F->cap)
+        frontier_grow(F);
+
+    int i = F->n++;
+    while (i > 0) {
+        int p = (i - 1) / 2;
+        if (F->a[p]->key <= x->key)
+            break;
+        F->a[i] = F->a[p];
+        i = p;
+    }
+    F->a[i] = x;
+}
+
+/* move x down from slot i to its place among the first F->n slots */
+static void frontier_sift_down(NodeFrontier *F, int i, FibNode *x) {
+    for (;;) {
+        int c = 2 * i + 1;
+        if (c >= F->n)
+            break;
+        if (c + 1 < F->n && F->a[c + 1]->key < F->a[c]->key)
+            c++;
+        if (x->key <= F->a[c]->key)
+            break;
+        F->a[i] = F->a[c];
+        i = c;
+    }
+    F->a[i] = x;
+}
+
+static FibNode* frontier_pop(NodeFrontier *F) {
+    FibNode *top = F->a[0];
+    FibNode *x = F->a[--F->n];
+
+    if (F->n > 0)
+        frontier_sift_down(F, 0, x);
+    return top;
+}
+
+/* push the whole sibling ring starting at x */
+static void frontier_push_ring(NodeFrontier *F, FibNode *x) {
+    FibNode *w = x;
+    do {
+        frontier_push(F, w);
+        w = w->right;
+    } while (w != x);
+}
+
+/* seed an empty frontier with the root ring: append, then heapify
+   bottom-up, O(r) for r roots instead of r sift-up pushes */
+static void frontier_seed(NodeFrontier *F, FibNode *x) {
+    FibNode *w = x;
+    do {
+        if (F->n == F->cap)
+            frontier_grow(F);
+        F->a[F->n++] = w;
+        w = w->right;
+    } while (w != x);
+
+    for (int i = F->n / 2 - 1; i >= 0; i--)
+        frontier_sift_down(F, i, F->a[i]);
+}
+
+/* ============================
+   BATCH EXTRACTION
+   ============================
+   Pops up to k nodes with key <= bound in ascending order. The popped set
+   is closed under "parent of", so once it is removed, the nodes left in the
+   frontier (unpopped roots plus children of popped nodes) are exactly the
+   new root list. That list is consolidated once for the whole batch. */
+static int extract_batch(FibHeap *H, int k, int bound, FibNode **out) {
+    if (H->min == NULL || k <= 0 || H->min->key > bound)
+        return 0;
+
+    /* the frontier borrows the root snapshot buffer */
+    NodeFrontier F = { H->roots, 0, H->roots_cap };
+    frontier_seed(&F, H->min);
+
+    int count = 0;
+    while (count < k && F.n > 0 && F.a[0]->key <= bound) {
+        FibNode *x = frontier_pop(&F);
+        if (x->child != NULL)
+            frontier_push_ring(&F, x->child);
+        if (x->dead) {
+            H->n_dead--;
+            fib_heap_release_node(H, x);
+            continue;
+        }
+        index_remove(H, x);
+        out[count++] = x;
+    }
+
+    /* relink the leftovers as the root list */
+    H->min = NULL;
+    for (int i = 0; i < F.n; i++) {
+        FibNode *x = F.a[i];
+        if (x->parent != NULL) {
+            x->parent = NULL;
+            x->mark = 0;
+        }
+        insert_into_root(H, x);
+    }
+    H->roots = F.a;
+    H->roots_cap = F.cap;
+
+    H->n -= count;
+    if (H->min != NULL)
+        fib_heap_consolidate(H);
+
+    return count;
+}
+
+/* Extract the k smallest keys into out (ascending); returns how many */
+int fib_heap_extract_k(FibHeap *H, int k, FibNode **out) {
+    return extract_batch(H, k, INT_MAX, out);
+}
+
+/* Extract every key <= bound, at most max of them, into out (ascending) */
+int fib_heap_extract_upto(FibHeap *H, int bound, FibNode **out, int max) {
+    return extract_batch(H, max, bound, out);
+}
+
+/* ============================
+   PEEK / ORDERED ITERATION
+   ============================
+   The same frontier walk as batch extraction, but nothing is unlinked:
+   the forest is only read. Seeding heapifies the r roots in O(r), and
+   each step pops one node and pushes its children, O(log n) pushes at
+   most. */
+
+/* Copy the k smallest live nodes into out (ascending); returns how many */
+int fib_heap_peek_k(FibHeap *H, int k, FibNode **out) {
+    if (H->min == NULL || k <= 0)
+        return 0;
+
+    NodeFrontier F = { H->roots, 0, H->roots_cap };
+    frontier_seed(&F, H->min);
+
+    int count = 0;
+    while (count < k && F.n > 0) {
+        FibNode *x = frontier_pop(&F);
+        if (x->child != NULL)
+            frontier_push_ring(&F, x->child);
+        if (!x->dead)
+            out[count++] = x;
+    }
+
+    H->roots = F.a;
+    H->roots_cap = F.cap;
+    return count;
+}
+
+/* The iterator owns its frontier, so several may run at once. The heap
+   must not change while one is in use. */
+void fib_heap_iter_init(FibHeapIter *it, FibHeap *H) {
+    NodeFrontier F = { NULL, 0, 0 };
+    if (H->min != NULL)
+        frontier_seed(&F, H->min);
+    it->frontier = F.a;
+    it->n = F.n;
+    it->cap = F.cap;
+}
+
+/* Next live node in ascending key order, or NULL when done */
+FibNode* fib_heap_iter_next(FibHeapIter *it) {
+    NodeFrontier F = { it->frontier, it->n, it->cap };
+    FibNode *x = NULL;
+
+    while (F.n > 0) {
+        FibNode *y = frontier_pop(&F);
+        if (y->child != NULL)
+            frontier_push_ring(&F, y->child);
+        if (!y->dead) {
+            x = y;
+            break;
+        }
+    }
+
+    it->frontier = F.a;
+    it->n = F.n;
+    it->cap = F.cap;
+    return x;
+}
+
+void fib_heap_iter_free(FibHeapIter *it) {
+    free(it->frontier);
+    it->frontier = NULL;
+    it->n = it->cap = 0;
+}
+
 /* ============================
    CUT OPERATIONS
    ============================ */
@@ -226,31 +1016,39 @@ static void fib_heap_cut(FibHeap *H, FibNode *x, FibNode *y) {
 
     x->parent = NULL;
     x->mark = 0;
+    STAT_INC(H, cuts);
 
     insert_into_root(H, x);
 }
 
+/* Walk up from y: mark the first unmarked ancestor, cut marked ones */
 static void fib_heap_cascading_cut(FibHeap *H, FibNode *y) {
+    int depth = 0;
     FibNode *z = y->parent;
-    if (z != NULL) {
-        if (y->mark == 0)
+
+    while (z != NULL) {
+        if (y->mark == 0) {
             y->mark = 1;
-        else {
-            fib_heap_cut(H, y, z);
-            fib_heap_cascading_cut(H, z);
+            break;
         }
+        fib_heap_cut(H, y, z);
+        STAT_INC(H, cascade_cuts);
+        depth++;
+        y = z;
+        z = y->parent;
     }
+
+#ifdef FIB_HEAP_STATS
+    if (depth > H->stats.max_cascade_depth)
+        H->stats.max_cascade_depth = depth;
+#endif
+    (void)depth;
 }
 
 /* ============================
    DECREASE KEY
    ============================ */
-void fib_heap_decrease_key(FibHeap *H, FibNode *x, int k) {
-    if (k > x->key) {
-        printf("Error: new key is greater than current key\n");
-        return;
-    }
-
+static void decrease_key(FibHeap *H, FibNode *x, int k) {
     x->key = k;
     FibNode *y = x->parent;
 
@@ -263,37 +1061,553 @@ void fib_heap_decrease_key(FibHeap *H, FibNode *x, int k) {
         H->min = x;
 }
 
+/* Returns 0, or -1 if k is larger than the current key or x is deleted */
+int fib_heap_decrease_key(FibHeap *H, FibNode *x, int k) {
+    if (k > x->key || x->dead)
+        return -1;
+
+    STAT_TIMER_START(t0);
+    decrease_key(H, x, k);
+    STAT_TIMER_STOP(H, FIB_OP_DECREASE_KEY, t0);
+    return 0;
+}
+
+/* ============================
+   INCREASE KEY
+   ============================
+   x's children may now be smaller than x, so they are cut to the root
+   list. x itself is cut from its parent as well: keeping it there with
+   degree 0 would break the subtree-size bound that limits degrees. Only
+   when x was the min must the root list be consolidated to find the new
+   one, which makes that case cost as much as an extract. */
+static void increase_key(FibHeap *H, FibNode *x, int k) {
+    /* children go up while x still has its old key, so none of them can
+       displace a min that is not x */
+    FibNode *c = x->child;
+    if (c != NULL) {
+        FibNode *w = c;
+        do {
+            FibNode *next = w->right;
+            w->parent = NULL;
+            w->mark = 0;
+            insert_into_root(H, w);
+            STAT_INC(H, cuts);
+            w = next;
+        } while (w != c);
+        x->child = NULL;
+        x->degree = 0;
+    }
+    x->key = k;
+
+    FibNode *y = x->parent;
+    if (y != NULL) {
+        fib_heap_cut(H, x, y);
+        fib_heap_cascading_cut(H, y);
+    }
+
+    if (x == H->min)
+        fib_heap_consolidate(H);
+}
+
+/* Move x's key to k in either direction, in place. Returns 0, or -1 if x
+   is deleted. */
+int fib_heap_update_key(FibHeap *H, FibNode *x, int k) {
+    if (x->dead)
+        return -1;
+
+    if (k < x->key) {
+        STAT_TIMER_START(t0);
+        decrease_key(H, x, k);
+        STAT_TIMER_STOP(H, FIB_OP_DECREASE_KEY, t0);
+    } else if (k > x->key) {
+        STAT_TIMER_START(t0);
+        increase_key(H, x, k);
+        STAT_TIMER_STOP(H, FIB_OP_INCREASE_KEY, t0);
+    }
+    return 0;
+}
+
 /* ============================
    DELETE NODE
-   ============================ */
+   ============================
+   Deleting the min extracts it. Any other node is only marked dead: it
+   leaves n and the id index at once but stays linked with its key, so
+   heap order still holds. Consolidation purges dead roots, and once the
+   dead outnumber the live the whole forest is purged. Deleting a node
+   that is already dead does nothing. */
+#define FIB_PURGE_MIN 64
+
 void fib_heap_delete(FibHeap *H, FibNode *x) {
-    fib_heap_decrease_key(H, x, INT_MIN);
-    FibNode *m = fib_heap_extract_min(H);
-    free(m);
+    if (x->dead)
+        return;
+
+    STAT_TIMER_START(t0);
+    if (x == H->min) {
+        fib_heap_release_node(H, extract_min(H));
+    } else {
+        x->dead = 1;
+        index_remove(H, x);
+        x->id = -1;
+        H->n--;
+        H->n_dead++;
+        if (H->n_dead >= FIB_PURGE_MIN && H->n_dead > H->n)
+            fib_heap_purge(H);
+    }
+    STAT_TIMER_STOP(H, FIB_OP_DELETE, t0);
 }
 
 /* ============================
-   FIND NODE (DEEP SEARCH)
-   ============================ */
-FibNode* fib_heap_find(FibNode *root, int key) {
-    if (!root) return NULL;
+   TRAVERSAL
+   ============================
+   Iterative pre-order walk over a forest, driven by an explicit stack of
+   (first sibling, next sibling) frames. A node's child and right pointers
+   are read before it is visited, so a visitor may free the node. */
+#define WALK_INLINE_FRAMES 64
+
+typedef struct WalkFrame {
+    FibNode *start;
+    FibNode *next;
+} WalkFrame;
+
+static int forest_walk(FibNode *root, FibVisitor visit, void *ctx) {
+    if (root == NULL)
+        return 0;
+
+    WalkFrame inline_frames[WALK_INLINE_FRAMES];
+    WalkFrame *stack = inline_frames;
+    int cap = WALK_INLINE_FRAMES;
+    int top = 0;
+    int stopped = 0;
+
+    stack[0].start = stack[0].next = root;
+
+    while (top >= 0) {
+        FibNode *x = stack[top].next;
+        if (x == NULL) {
+            top--;
+            continue;
+        }
 
-    FibNode *start = root;
-    FibNode *w = root;
+        FibNode *right = x->right;
+        FibNode *child = x->child;
+        stack[top].next = (right == stack[top].start) ? NULL : right;
 
-    do {
-        if (w->key == key)
-            return w;
+        int r = visit(x, top, ctx);
+        if (r == FIB_VISIT_STOP) {
+            stopped = 1;
+            break;
+        }
 
-        if (w->child) {
-            FibNode *res = fib_heap_find(w->child, key);
-            if (res) return res;
+        if (child != NULL && r != FIB_VISIT_SKIP_CHILDREN) {
+            if (top + 1 == cap) {
+                cap *= 2;
+                if (stack == inline_frames) {
+                    stack = (WalkFrame*)malloc(cap * sizeof(WalkFrame));
+                    memcpy(stack, inline_frames, sizeof(inline_frames));
+                } else {
+                    stack = (WalkFrame*)realloc(stack, cap * sizeof(WalkFrame));
+                }
+            }
+            top++;
+            stack[top].start = stack[top].next = child;
         }
+    }
 
-        w = w->right;
-    } while (w != start);
+    if (stack != inline_frames)
+        free(stack);
+    return stopped;
+}
 
-    return NULL;
+typedef struct LiveCtx {
+    FibVisitor visit;
+    void *ctx;
+} LiveCtx;
+
+/* hide dead nodes but keep walking below them */
+static int live_visitor(FibNode *x, int depth, void *ctx) {
+    LiveCtx *l = (LiveCtx*)ctx;
+    if (x->dead)
+        return FIB_VISIT_CONTINUE;
+    return l->visit(x, depth, l->ctx);
+}
+
+/* Visit every live node; returns 1 if the visitor stopped the walk early */
+int fib_heap_foreach(FibHeap *H, FibVisitor visit, void *ctx) {
+    if (H->n_dead == 0)
+        return forest_walk(H->min, visit, ctx);
+
+    LiveCtx l = { visit, ctx };
+    return forest_walk(H->min, live_visitor, &l);
+}
+
+/* ============================
+   PURGE DEAD NODES
+   ============================
+   Cut every dead non-root to the root list, then consolidate, which drops
+   the dead roots. O(n) for the walk. */
+typedef struct DeadCtx {
+    FibNode **a;
+    int n;
+} DeadCtx;
+
+static int dead_visitor(FibNode *x, int depth, void *ctx) {
+    DeadCtx *d = (DeadCtx*)ctx;
+    if (x->dead && depth > 0)
+        d->a[d->n++] = x;
+    return FIB_VISIT_CONTINUE;
+}
+
+void fib_heap_purge(FibHeap *H) {
+    if (H->n_dead == 0 || H->min == NULL)
+        return;
+
+    DeadCtx d = { (FibNode**)malloc(H->n_dead * sizeof(FibNode*)), 0 };
+    forest_walk(H->min, dead_visitor, &d);
+
+    for (int i = 0; i < d.n; i++) {
+        FibNode *x = d.a[i];
+        FibNode *y = x->parent;
+        /* an earlier cascade may already have moved x to the roots */
+        if (y != NULL) {
+            fib_heap_cut(H, x, y);
+            fib_heap_cascading_cut(H, y);
+        }
+    }
+    free(d.a);
+
+    fib_heap_consolidate(H);
+}
+
+/* ============================
+   SNAPSHOT SAVE / LOAD
+   ============================
+   A 32-byte header followed by one 12-byte record per node in pre-order,
+   children in ring order from ->child. Dead nodes are saved too, since
+   they may hold live children. Records carry no pointers: the shape is
+   implied by the order and each node's degree, so a saved file rebuilds
+   the same forest on load without any consolidation. */
+#define SNAP_MAGIC "FIBSNP2"     /* 1 had degree << 1 | mark, no dead bit */
+#define SNAP_BUFFER 4096
+
+typedef struct SnapHeader {
+    char magic[8];
+    int64_t n;
+    int64_t reserved[2];
+} SnapHeader;
+
+typedef struct SnapRecord {
+    int32_t key;
+    int32_t id;
+    int32_t flags;              /* degree << 2 | dead << 1 | mark */
+} SnapRecord;
+
+typedef struct SnapWriter {
+    FILE *f;
+    SnapRecord buf[SNAP_BUFFER];
+    int used;
+    int ok;
+} SnapWriter;
+
+static void snap_flush(SnapWriter *w) {
+    if (w->used > 0 && fwrite(w->buf, sizeof(SnapRecord), w->used, w->f) != (size_t)w->used)
+        w->ok = 0;
+    w->used = 0;
+}
+
+static int snap_visitor(FibNode *x, int depth, void *ctx) {
+    SnapWriter *w = (SnapWriter*)ctx;
+    (void)depth;
+
+    SnapRecord *r = &w->buf[w->used++];
+    r->key = x->key;
+    r->id = x->id;
+    r->flags = (x->degree << 2) | ((x->dead & 1) << 1) | (x->mark & 1);
+    if (w->used == SNAP_BUFFER)
+        snap_flush(w);
+    return FIB_VISIT_CONTINUE;
+}
+
+/* Returns 0, or -1 if the file could not be written */
+int fib_heap_save(FibHeap *H, const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return -1;
+
+    SnapHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, SNAP_MAGIC, sizeof(SNAP_MAGIC));
+    h.n = H->n + H->n_dead;     /* records, not live nodes */
+
+    SnapWriter *w = (SnapWriter*)malloc(sizeof(SnapWriter));
+    w->f = f;
+    w->used = 0;
+    w->ok = fwrite(&h, sizeof(h), 1, f) == 1;
+
+    /* the walk starts at min, so record 0 is always the minimum */
+    forest_walk(H->min, snap_visitor, w);
+    snap_flush(w);
+
+    int ok = w->ok;
+    free(w);
+    if (fclose(f) != 0)
+        ok = 0;
+    return ok ? 0 : -1;
+}
+
+typedef struct SnapFrame {
+    FibNode *node;
+    int remaining;              /* children still to attach */
+} SnapFrame;
+
+/* Attach x as the last child of p */
+static void snap_add_child(FibNode *p, FibNode *x) {
+    FibNode *c = p->child;
+    x->parent = p;
+    if (c == NULL) {
+        p->child = x;
+        x->left = x->right = x;
+    } else {
+        x->right = c;
+        x->left = c->left;
+        c->left->right = x;
+        c->left = x;
+    }
+}
+
+/* Where load takes records from: the mapped file, or a stdio buffer */
+typedef struct SnapSource {
+    int64_t n;
+    const SnapRecord *rec;      /* mapped records, NULL when streaming */
+    void *map;
+    size_t map_len;
+    FILE *f;
+    int pos;
+    int len;
+    SnapRecord buf[SNAP_BUFFER];
+} SnapSource;
+
+static int snap_header_ok(const SnapHeader *h, size_t len) {
+    return memcmp(h->magic, SNAP_MAGIC, sizeof(SNAP_MAGIC)) == 0
+        && h->n >= 0 && h->n <= INT_MAX
+        && len == sizeof(SnapHeader) + (size_t)h->n * sizeof(SnapRecord);
+}
+
+/* Returns 0 once the header and file size check out */
+static int snap_open(SnapSource *src, const char *path) {
+    src->rec = NULL;
+    src->map = NULL;
+    src->f = NULL;
+    src->pos = src->len = 0;
+
+#ifdef FIB_SNAP_MMAP
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(SnapHeader)) {
+        close(fd);
+        return -1;
+    }
+
+    size_t len = (size_t)st.st_size;
+    void *map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return -1;
+
+    const SnapHeader *h = (const SnapHeader*)map;
+    if (!snap_header_ok(h, len)) {
+        munmap(map, len);
+        return -1;
+    }
+#ifdef MADV_SEQUENTIAL
+    madvise(map, len, MADV_SEQUENTIAL);
+#endif
+
+    src->n = h->n;
+    src->rec = (const SnapRecord*)((const char*)map + sizeof(SnapHeader));
+    src->map = map;
+    src->map_len = len;
+    return 0;
+#else
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return -1;
+
+    SnapHeader h;
+    long len = -1;
+    if (fseek(f, 0, SEEK_END) == 0)
+        len = ftell(f);
+    rewind(f);
+    if (len < (long)sizeof(SnapHeader) || fread(&h, sizeof(h), 1, f) != 1
+        || !snap_header_ok(&h, (size_t)len)) {
+        fclose(f);
+        return -1;
+    }
+
+    src->n = h.n;
+    src->f = f;
+    return 0;
+#endif
+}
+
+/* Next record, or NULL if the stream ends early */
+static const SnapRecord* snap_next(SnapSource *src) {
+    if (src->rec != NULL)
+        return src->rec++;
+
+    if (src->pos == src->len) {
+        src->len = (int)fread(src->buf, sizeof(SnapRecord), SNAP_BUFFER, src->f);
+        src->pos = 0;
+        if (src->len == 0)
+            return NULL;
+    }
+    return &src->buf[src->pos++];
+}
+
+static void snap_close(SnapSource *src) {
+#ifdef FIB_SNAP_MMAP
+    if (src->map != NULL)
+        munmap(src->map, src->map_len);
+#endif
+    if (src->f != NULL)
+        fclose(src->f);
+}
+
+/* Read a file written by fib_heap_save and rebuild its forest. Nodes come
+   from one pool run (one malloc each with FIB_HEAP_NO_POOL). Returns NULL
+   if the file is missing or its records do not describe a valid heap:
+   wrong size, a degree running past the end, a child keyed below its
+   parent, or an id repeated or above FIB_ID_MAX. */
+FibHeap* fib_heap_load(const char *path) {
+    SnapSource *src = (SnapSource*)malloc(sizeof(SnapSource));
+    if (snap_open(src, path) != 0) {
+        free(src);
+        return NULL;
+    }
+
+    int n = (int)src->n;
+    FibHeap *H = make_fib_heap();
+
+#ifndef FIB_HEAP_NO_POOL
+    FibNode *run = n > 0 ? pool_alloc_run(&H->pool, n) : NULL;
+#endif
+
+    int cap = 64;
+    int top = -1;
+    SnapFrame *stack = (SnapFrame*)malloc(cap * sizeof(SnapFrame));
+    int valid = 1;
+
+    for (int i = 0; i < n && valid; i++) {
+        const SnapRecord *r = snap_next(src);
+        if (r == NULL) {
+            valid = 0;
+            break;
+        }
+
+        int degree = r->flags >> 2;
+        int dead = (r->flags >> 1) & 1;
+        /* record 0 is the saved min, which is live */
+        if (r->flags < 0 || degree > n - 1 - i || (dead && i == 0)) {
+            valid = 0;
+            break;
+        }
+
+#ifndef FIB_HEAP_NO_POOL
+        FibNode *x = &run[i];
+#else
+        FibNode *x = make_fib_node(r->key);
+#endif
+        x->key = r->key;
+        x->id = r->id < 0 || dead ? -1 : r->id;
+        x->degree = degree;
+        x->mark = r->flags & 1;
+        x->dead = dead;
+        x->parent = NULL;
+        x->child = NULL;
+
+        if (top >= 0) {
+            FibNode *p = stack[top].node;
+            if (x->key < p->key)
+                valid = 0;
+            snap_add_child(p, x);
+            if (--stack[top].remaining == 0)
+                top--;
+        } else if (H->min == NULL) {
+            H->min = x;
+            x->left = x->right = x;
+        } else {
+            x->right = H->min;
+            x->left = H->min->left;
+            H->min->left->right = x;
+            H->min->left = x;
+            if (!dead && x->key < H->min->key)
+                H->min = x;
+        }
+        if (dead)
+            H->n_dead++;
+        else
+            H->n++;
+
+        if (x->id >= 0) {
+            if (index_reserve(H, x->id) != 0 || H->index[x->id] != NULL) {
+                x->id = -1;
+                valid = 0;
+            } else {
+                H->index[x->id] = x;
+            }
+        }
+
+        if (degree > 0) {
+            if (++top == cap) {
+                cap *= 2;
+                stack = (SnapFrame*)realloc(stack, cap * sizeof(SnapFrame));
+            }
+            stack[top].node = x;
+            stack[top].remaining = degree;
+        }
+    }
+
+    if (top >= 0)
+        valid = 0;
+
+    free(stack);
+    snap_close(src);
+    free(src);
+
+    if (!valid) {
+        /* every node made so far is linked, so the forest frees cleanly */
+        fib_heap_free(H);
+        return NULL;
+    }
+    return H;
+}
+
+/* ============================
+   FIND NODE (DEEP SEARCH)
+   ============================ */
+typedef struct FindCtx {
+    int key;
+    FibNode *found;
+} FindCtx;
+
+static int find_visitor(FibNode *x, int depth, void *ctx) {
+    FindCtx *f = (FindCtx*)ctx;
+    (void)depth;
+
+    if (x->key == f->key && !x->dead) {
+        f->found = x;
+        return FIB_VISIT_STOP;
+    }
+    /* heap order: nothing below a larger key can match */
+    return x->key > f->key ? FIB_VISIT_SKIP_CHILDREN : FIB_VISIT_CONTINUE;
+}
+
+FibNode* fib_heap_find(FibNode *root, int key) {
+    FindCtx f = { key, NULL };
+    forest_walk(root, find_visitor, &f);
+    return f.found;
 }
 
 /* ============================
@@ -305,47 +1619,60 @@ void fib_heap_print(FibHeap *H) {
         return;
     }
 
-    FibNode *x = H->min;
+    /* walk the root ring itself: foreach would descend into the subtrees
+       of dead roots, whose children are not roots */
     printf("Root list: ");
+    FibNode *w = H->min;
     do {
-        printf("%d ", x->key);
-        x = x->right;
-    } while (x != H->min);
-
+        if (!w->dead)
+            printf("%d ", w->key);
+        w = w->right;
+    } while (w != H->min);
     printf("\n");
 }
 
 /* ============================
    FREE HEAP
    ============================ */
-static void free_recursive(FibNode *x) {
-    if (!x) return;
-
-    FibNode *start = x;
-    FibNode *w = x;
-
-    do {
-        FibNode *next = w->right;
-        if (w->child)
-            free_recursive(w->child);
-        free(w);
-        w = next;
-    } while (w != start);
+#ifdef FIB_HEAP_NO_POOL
+static int free_visitor(FibNode *x, int depth, void *ctx) {
+    (void)depth;
+    (void)ctx;
+    free(x);
+    return FIB_VISIT_CONTINUE;
 }
+#endif
 
 void fib_heap_free(FibHeap *H) {
-    if (H->min)
-        free_recursive(H->min);
+#ifndef FIB_HEAP_NO_POOL
+    /* every node lives in a slab: release them all at once */
+    pool_destroy(&H->pool);
+#else
+    forest_walk(H->min, free_visitor, NULL);
+#endif
+    free(H->index);
+    scratch_free(H);
     free(H);
 }
 
+/* Forget every node in O(1). Only for heaps filled through
+   fib_heap_insert_node with caller-owned nodes: nothing is freed, and
+   the nodes must not be used with this heap afterwards. */
+void fib_heap_reset(FibHeap *H) {
+    H->min = NULL;
+    H->n = 0;
+    H->n_dead = 0;
+}
+
 /* ============================
    MAIN
    ============================ */
+#ifndef FIB_HEAP_NO_MAIN
 
 int main() {
     FibHeap *H = make_fib_heap();
-    int choice, key, newKey;
+    int choice, key, newKey, id;
+    int next_id = 0;
 
     printf("\n=============================================\n");
     printf("        Fibonacci Heap Implementation         \n");
@@ -356,7 +1683,7 @@ int main() {
         printf("1. Insert a key\n");
         printf("2. Find Minimum\n");
         printf("3. Extract Minimum\n");
-        printf("4. Decrease a Key\n");
+        printf("4. Change a Key\n");
         printf("5. Delete a Key\n");
         printf("6. Display Root List\n");
         printf("7. Exit\n");
@@ -375,8 +1702,9 @@ int main() {
                 printf("Enter key to insert: ");
                 scanf("%d", &key);
 
-                fib_heap_insert(H, key);
-                printf("Inserted key %d successfully.\n", key);
+                fib_heap_insert_with_id(H, key, next_id);
+                printf("Inserted key %d successfully (id %d).\n", key, next_id);
+                next_id++;
                 break;
 
             /* ---------------------- FIND MIN ---------------------- */
@@ -394,44 +1722,50 @@ int main() {
                 FibNode *minNode = fib_heap_extract_min(H);
                 if (minNode) {
                     printf("Extracted minimum key: %d\n", minNode->key);
-                    free(minNode);
+                    fib_heap_release_node(H, minNode);
                 } else {
                     printf("Heap is empty.\n");
                 }
                 break;
             }
 
-            /* ---------------------- DECREASE KEY ---------------------- */
+            /* ---------------------- CHANGE KEY ---------------------- */
             case 4: {
-                printf("Enter the key to decrease: ");
-                scanf("%d", &key);
+                printf("Enter id of the key to change: ");
+                scanf("%d", &id);
 
-                FibNode *node = fib_heap_find(H->min, key);
+                FibNode *node = fib_heap_find_by_id(H, id);
                 if (!node) {
-                    printf("Key %d not found (deep search).\n", key);
+                    printf("Id %d not found.\n", id);
                     break;
                 }
 
-                printf("Enter new (smaller) key: ");
+                printf("Enter new key: ");
                 scanf("%d", &newKey);
 
-                fib_heap_decrease_key(H, node, newKey);
-                printf("Key %d decreased to %d successfully.\n", key, newKey);
+                key = node->key;
+                if (fib_heap_update_key_by_id(H, id, newKey) != 0) {
+                    printf("Error: could not change key %d\n", key);
+                    break;
+                }
+                printf("Key %d %s to %d successfully.\n", key,
+                       newKey < key ? "decreased" : newKey > key ? "increased" : "kept", newKey);
                 break;
             }
 
             /* ---------------------- DELETE KEY ---------------------- */
             case 5: {
-                printf("Enter key to delete: ");
-                scanf("%d", &key);
+                printf("Enter id of the key to delete: ");
+                scanf("%d", &id);
 
-                FibNode *node = fib_heap_find(H->min, key);
+                FibNode *node = fib_heap_find_by_id(H, id);
                 if (!node) {
-                    printf("Key %d not found (deep search).\n", key);
+                    printf("Id %d not found.\n", id);
                     break;
                 }
 
-                fib_heap_delete(H, node);
+                key = node->key;
+                fib_heap_delete_by_id(H, id);
                 printf("Deleted key %d successfully.\n", key);
                 break;
             }
@@ -455,3 +1789,5 @@ int main() {
     fib_heap_free(H);
     return 0;
 }
+
+#endif /* FIB_HEAP_NO_MAIN */
@@ -7,7 +7,9 @@
 typedef struct FibNode {
     int key;
     int degree;
-    int mark;
+    unsigned char mark;
+    unsigned char dead;     /* deleted but still linked; see fib_heap_delete */
+    int id;     /* user id from fib_heap_insert_with_id, -1 if none */
 
     struct FibNode *parent;
     struct FibNode *child;
@@ -16,9 +18,68 @@ typedef struct FibNode {
 
 } FibNode;
 
+/* Node pool: slab-allocated nodes recycled through a freelist.
+   Compile with -DFIB_HEAP_NO_POOL to fall back to one malloc per node. */
+typedef struct FibSlab {
+    struct FibSlab *next;
+    int capacity;
+    FibNode nodes[];
+} FibSlab;
+
+typedef struct FibNodePool {
+    FibSlab *slabs;
+    FibNode *free_list;   /* recycled nodes, linked through ->right */
+    FibNode *free_tail;
+    int used;             /* nodes handed out from slabs->nodes */
+} FibNodePool;
+
+/* Operation counters and latency histograms, compiled in with
+   -DFIB_HEAP_STATS. Every file sharing a FibHeap must use the same flag,
+   since the block changes the struct layout. */
+enum {
+    FIB_OP_INSERT,
+    FIB_OP_EXTRACT_MIN,
+    FIB_OP_DECREASE_KEY,
+    FIB_OP_INCREASE_KEY,
+    FIB_OP_DELETE,
+    FIB_OP_UNION,
+    FIB_OP_COUNT
+};
+
+#ifdef FIB_HEAP_STATS
+#include "lat_hist.h"
+
+typedef struct FibHeapStats {
+    unsigned long long links;           /* fib_heap_link calls */
+    unsigned long long cuts;            /* all fib_heap_cut calls */
+    unsigned long long cascade_cuts;    /* cuts made by cascading cut */
+    int max_cascade_depth;              /* longest cascading-cut chain */
+    unsigned long long consolidations;
+    LatHist root_len;                   /* root-list length at consolidate start */
+    LatHist latency[FIB_OP_COUNT];      /* ns per public operation */
+} FibHeapStats;
+#endif
+
 typedef struct FibHeap {
     FibNode *min;
-    int n;
+    int n;              /* live nodes */
+    int n_dead;         /* deleted nodes not yet purged from the forest */
+#ifndef FIB_HEAP_NO_POOL
+    FibNodePool pool;
+#endif
+    FibNode **index;    /* id -> node, NULL if the id is not in the heap */
+    int index_cap;
+
+    /* consolidate scratch, reused across extract_min calls */
+    FibNode **degree_table;
+    int degree_cap;
+    FibNode **roots;
+    int roots_cap;
+    int *root_keys;     /* key shadow of the rebuilt root list */
+
+#ifdef FIB_HEAP_STATS
+    FibHeapStats stats;
+#endif
 } FibHeap;
 
 /* Creation */
@@ -27,15 +88,70 @@ FibNode* make_fib_node(int key);
 
 /* Operations */
 FibNode* fib_heap_insert(FibHeap *H, int key);
+void fib_heap_insert_node(FibHeap *H, FibNode *x, int key);
+void fib_heap_insert_batch(FibHeap *H, const int *keys, int n, FibNode **out_handles);
 FibNode* fib_heap_min(FibHeap *H);
 FibHeap* fib_heap_union(FibHeap *H1, FibHeap *H2);
+void fib_heap_meld(FibHeap *H1, FibHeap *H2);
+FibHeap* fib_heap_meld_many(FibHeap **heaps, int k);
 FibNode* fib_heap_extract_min(FibHeap *H);
-void fib_heap_decrease_key(FibHeap *H, FibNode *x, int k);
+int fib_heap_extract_k(FibHeap *H, int k, FibNode **out);
+int fib_heap_extract_upto(FibHeap *H, int bound, FibNode **out, int max);
+int fib_heap_decrease_key(FibHeap *H, FibNode *x, int k);
+int fib_heap_update_key(FibHeap *H, FibNode *x, int k);
 void fib_heap_delete(FibHeap *H, FibNode *x);
 
+/* Id index: O(1) lookup of nodes inserted with a non-negative id. The
+   table is sized by the largest id, so ids above FIB_ID_MAX are refused. */
+#ifndef FIB_ID_MAX
+#define FIB_ID_MAX ((1 << 28) - 1)
+#endif
+
+FibNode* fib_heap_insert_with_id(FibHeap *H, int key, int id);
+FibNode* fib_heap_find_by_id(FibHeap *H, int id);
+int fib_heap_decrease_key_by_id(FibHeap *H, int id, int k);
+int fib_heap_update_key_by_id(FibHeap *H, int id, int k);
+int fib_heap_delete_by_id(FibHeap *H, int id);
+
+/* Traversal: visitor returns one of the FIB_VISIT_* codes; depth is 0 for roots */
+enum {
+    FIB_VISIT_CONTINUE,
+    FIB_VISIT_SKIP_CHILDREN,
+    FIB_VISIT_STOP
+};
+
+typedef int (*FibVisitor)(FibNode *x, int depth, void *ctx);
+
+int fib_heap_foreach(FibHeap *H, FibVisitor visit, void *ctx);
+
+/* Ordered, non-destructive: the k smallest keys, or every key lazily */
+typedef struct FibHeapIter {
+    FibNode **frontier;     /* binary min-heap of nodes still to visit */
+    int n;
+    int cap;
+} FibHeapIter;
+
+int fib_heap_peek_k(FibHeap *H, int k, FibNode **out);
+void fib_heap_iter_init(FibHeapIter *it, FibHeap *H);
+FibNode* fib_heap_iter_next(FibHeapIter *it);
+void fib_heap_iter_free(FibHeapIter *it);
+
+/* Snapshot: save the whole forest to a file and map it back without consolidating */
+int fib_heap_save(FibHeap *H, const char *path);
+FibHeap* fib_heap_load(const char *path);
+
 /* Utility */
 void fib_heap_print(FibHeap *H);
 void fib_heap_free(FibHeap *H);
+void fib_heap_reset(FibHeap *H);
+void fib_heap_purge(FibHeap *H);
+
+/* Stats: no-ops unless built with -DFIB_HEAP_STATS */
+void fib_heap_stats_reset(FibHeap *H);
+void fib_heap_stats_dump(FibHeap *H, FILE *out);
+
+/* Memory: give back a node returned by fib_heap_extract_min */
+void fib_heap_release_node(FibHeap *H, FibNode *x);
 
 /* Helper */
 FibNode* fib_heap_find(FibNode *root, int key);
@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <sched.h>
+
+#include "multiqueue.h"
+#include "fib_heap_template.h"
+
+FIBHEAP_DEFINE(mqfib, int, int, FIBHEAP_LT)
+
+/* One shard per cache line. top and n mirror the heap so other threads
+   can compare shards without taking the lock. */
+typedef struct MQShard {
+    _Alignas(64) atomic_int locked;
+    atomic_int top;     /* min key, valid when n > 0 */
+    atomic_int n;
+    mqfib_heap *heap;
+} MQShard;
+
+/* ============================
+   PER-THREAD RANDOM SHARDS
+   ============================ */
+static atomic_ullong mq_seed = 0x9E3779B97F4A7C15ULL;
+static _Thread_local unsigned long long mq_rng;
+
+static unsigned int mq_rand(void) {
+    if (mq_rng == 0)
+        mq_rng = atomic_fetch_add(&mq_seed, 0x9E3779B97F4A7C15ULL) | 1;
+    mq_rng ^= mq_rng << 13;
+    mq_rng ^= mq_rng >> 7;
+    mq_rng ^= mq_rng << 17;
+    return (unsigned int)(mq_rng >> 32);
+}
+
+static MQShard* random_shard(MultiQueue *Q) {
+    return &Q->shards[mq_rand() % (unsigned int)Q->nshards];
+}
+
+/* ============================
+   SHARD LOCKING
+   ============================ */
+static int shard_trylock(MQShard *s) {
+    if (atomic_load_explicit(&s->locked, memory_order_relaxed))
+        return 0;
+    return atomic_exchange_explicit(&s->locked, 1, memory_order_acquire) == 0;
+}
+
+static void shard_lock(MQShard *s) {
+    while (!shard_trylock(s))
+        sched_yield();
+}
+
+/* Publish the new min and size, then release */
+static void shard_unlock(MQShard *s) {
+    mqfib_heap *H = s->heap;
+    if (H->min != NULL)
+        atomic_store_explicit(&s->top, H->min->key, memory_order_relaxed);
+    atomic_store_explicit(&s->n, H->n, memory_order_relaxed);
+    atomic_store_explicit(&s->locked, 0, memory_order_release);
+}
+
+/* ============================
+   BASIC CREATION FUNCTIONS
+   ============================ */
+MultiQueue* make_multiqueue(int threads, int c) {
+    if (threads < 1) threads = 1;
+    if (c < 1) c = 1;
+
+    MultiQueue *Q = (MultiQueue*)malloc(sizeof(MultiQueue));
+    Q->nshards = threads * c;
+    Q->shards = (MQShard*)aligned_alloc(_Alignof(MQShard), Q->nshards * sizeof(MQShard));
+
+    for (int i = 0; i < Q->nshards; i++) {
+        atomic_init(&Q->shards[i].locked, 0);
+        atomic_init(&Q->shards[i].top, 0);
+        atomic_init(&Q->shards[i].n, 0);
+        Q->shards[i].heap = mqfib_create();
+    }
+    return Q;
+}
+
+/* ============================
+   OPERATIONS
+   ============================ */
+void multiqueue_insert(MultiQueue *Q, int key, int value) {
+    MQShard *s;
+    do {
+        s = random_shard(Q);
+    } while (!shard_trylock(s));
+
+    mqfib_insert(s->heap, key, value);
+    shard_unlock(s);
+}
+
+/* Pop the min of a locked shard; unlocks it. Returns 0 if it was empty. */
+static int shard_pop(MQShard *s, int *key, int *value) {
+    mqfib_node *x = mqfib_extract_min(s->heap);
+    if (x == NULL) {
+        shard_unlock(s);
+        return 0;
+    }
+
+    *key = x->key;
+    *value = x->payload;
+    mqfib_release(s->heap, x);
+    shard_unlock(s);
+    return 1;
+}
+
+/* Two-choice extraction. When both picks look empty, sweep every shard
+   with a blocking lock; only a sweep that finds nothing reports empty. */
+int multiqueue_extract_min(MultiQueue *Q, int *key, int *value) {
+    for (;;) {
+        MQShard *a = random_shard(Q);
+        MQShard *b = random_shard(Q);
+        int na = atomic_load_explicit(&a->n, memory_order_relaxed);
+        int nb = atomic_load_explicit(&b->n, memory_order_relaxed);
+
+        if (na == 0 && nb == 0)
+            break;
+
+        MQShard *s = a;
+        if (na == 0 || (nb > 0 && atomic_load_explicit(&b->top, memory_order_relaxed) <
+                                  atomic_load_explicit(&a->top, memory_order_relaxed)))
+            s = b;
+
+        if (shard_trylock(s) && shard_pop(s, key, value))
+            return 1;
+    }
+
+    for (int i = 0; i < Q->nshards; i++) {
+        MQShard *s = &Q->shards[i];
+        if (atomic_load_explicit(&s->n, memory_order_relaxed) == 0)
+            continue;
+        shard_lock(s);
+        if (shard_pop(s, key, value))
+            return 1;
+    }
+    return 0;
+}
+
+int multiqueue_size(MultiQueue *Q) {
+    int n = 0;
+    for (int i = 0; i < Q->nshards; i++)
+        n += atomic_load_explicit(&Q->shards[i].n, memory_order_relaxed);
+    return n;
+}
+
+/* ============================
+   FREE
+   ============================ */
+void multiqueue_free(MultiQueue *Q) {
+    for (int i = 0; i < Q->nshards; i++)
+        mqfib_free(Q->shards[i].heap);
+    free(Q->shards);
+    free(Q);
+}
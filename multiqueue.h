@@ -0,0 +1,28 @@
+#ifndef MULTIQUEUE_H
+#define MULTIQUEUE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* MultiQueue: a relaxed concurrent priority queue made of independent
+   Fibonacci-heap shards, each behind a try-lock. insert picks a random
+   shard, and extract_min locks the better of two random shards, so the
+   key returned is small but not necessarily the global minimum.
+   Every function may be called from any number of threads. */
+typedef struct MultiQueue {
+    int nshards;
+    struct MQShard *shards;
+} MultiQueue;
+
+/* Creation: c * threads shards (c >= 2 is typical) */
+MultiQueue* make_multiqueue(int threads, int c);
+
+/* Operations */
+void multiqueue_insert(MultiQueue *Q, int key, int value);
+int multiqueue_extract_min(MultiQueue *Q, int *key, int *value);    /* 0 if empty */
+int multiqueue_size(MultiQueue *Q);     /* exact only when no thread is inside Q */
+
+/* Utility: not thread-safe */
+void multiqueue_free(MultiQueue *Q);
+
+#endif
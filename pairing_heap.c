@@ -0,0 +1,213 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "pairing_heap.h"
+
+#define PAIRING_CHUNK_MIN 64
+#define PAIRING_CHUNK_MAX 65536
+
+/* ============================
+   BASIC CREATION FUNCTIONS
+   ============================ */
+PairingHeap* make_pairing_heap() {
+    PairingHeap *H = (PairingHeap*)malloc(sizeof(PairingHeap));
+    H->root = NULL;
+    H->n = 0;
+    H->chunks = NULL;
+    H->used = 0;
+    H->free_list = NULL;
+    H->pairs = NULL;
+    H->pairs_cap = 0;
+    return H;
+}
+
+static PairingNode* alloc_node(PairingHeap *H) {
+    PairingNode *x = H->free_list;
+    if (x != NULL) {
+        H->free_list = x->next;
+        return x;
+    }
+
+    if (H->chunks == NULL || H->used == H->chunks->capacity) {
+        int cap = PAIRING_CHUNK_MIN;
+        if (H->chunks != NULL) {
+            cap = H->chunks->capacity * 2;
+            if (cap > PAIRING_CHUNK_MAX)
+                cap = PAIRING_CHUNK_MAX;
+        }
+        PairingChunk *c = (PairingChunk*)malloc(sizeof(PairingChunk) + (size_t)cap * sizeof(PairingNode));
+        c->capacity = cap;
+        c->next = H->chunks;
+        H->chunks = c;
+        H->used = 0;
+    }
+
+    return &H->chunks->nodes[H->used++];
+}
+
+void pairing_heap_release(PairingHeap *H, PairingNode *x) {
+    x->next = H->free_list;
+    H->free_list = x;
+}
+
+/* ============================
+   MELD TWO TREES
+   ============================ */
+static PairingNode* meld(PairingNode *a, PairingNode *b) {
+    if (a == NULL) return b;
+    if (b == NULL) return a;
+
+    if (b->key < a->key) {
+        PairingNode *t = a;
+        a = b;
+        b = t;
+    }
+
+    /* b becomes the first child of a */
+    b->next = a->child;
+    if (a->child != NULL)
+        a->child->prev = b;
+    b->prev = a;
+    a->child = b;
+    return a;
+}
+
+/* Unlink a non-root node (and its subtree) from its parent's child list */
+static void detach(PairingNode *x) {
+    if (x->prev->child == x)
+        x->prev->child = x->next;
+    else
+        x->prev->next = x->next;
+
+    if (x->next != NULL)
+        x->next->prev = x->prev;
+
+    x->next = x->prev = NULL;
+}
+
+/* Two-pass merge of a sibling list: pair left to right, then fold the
+   pairs right to left. Iterative, using the heap's scratch array. */
+static PairingNode* merge_siblings(PairingHeap *H, PairingNode *first) {
+    int count = 0;
+    for (PairingNode *c = first; c != NULL; ) {
+        PairingNode *next = c->next;
+        if (count == H->pairs_cap) {
+            H->pairs_cap = H->pairs_cap ? H->pairs_cap * 2 : 64;
+            H->pairs = (PairingNode**)realloc(H->pairs, H->pairs_cap * sizeof(PairingNode*));
+        }
+        c->next = c->prev = NULL;
+        H->pairs[count++] = c;
+        c = next;
+    }
+
+    if (count == 0)
+        return NULL;
+
+    int j = 0;
+    for (int i = 0; i < count; i += 2)
+        H->pairs[j++] = (i + 1 < count) ? meld(H->pairs[i], H->pairs[i + 1]) : H->pairs[i];
+
+    PairingNode *acc = H->pairs[j - 1];
+    for (int i = j - 2; i >= 0; i--)
+        acc = meld(H->pairs[i], acc);
+
+    return acc;
+}
+
+/* ============================
+   OPERATIONS
+   ============================ */
+PairingNode* pairing_heap_insert(PairingHeap *H, int key, int id) {
+    PairingNode *x = alloc_node(H);
+    x->key = key;
+    x->id = id;
+    x->child = x->next = x->prev = NULL;
+    H->root = meld(H->root, x);
+    H->n++;
+    return x;
+}
+
+PairingNode* pairing_heap_min(PairingHeap *H) {
+    return H->root;
+}
+
+PairingNode* pairing_heap_extract_min(PairingHeap *H) {
+    PairingNode *z = H->root;
+    if (z == NULL)
+        return NULL;
+
+    H->root = merge_siblings(H, z->child);
+    z->child = NULL;
+    H->n--;
+    return z;
+}
+
+/* Returns 0, or -1 if k is larger than the current key */
+int pairing_heap_decrease_key(PairingHeap *H, PairingNode *x, int k) {
+    if (k > x->key)
+        return -1;
+
+    x->key = k;
+    if (x != H->root) {
+        detach(x);
+        H->root = meld(H->root, x);
+    }
+    return 0;
+}
+
+void pairing_heap_delete(PairingHeap *H, PairingNode *x) {
+    if (x == H->root) {
+        pairing_heap_release(H, pairing_heap_extract_min(H));
+        return;
+    }
+
+    detach(x);
+    PairingNode *sub = merge_siblings(H, x->child);
+    H->root = meld(H->root, sub);
+    H->n--;
+    pairing_heap_release(H, x);
+}
+
+/* Meld H2 into H1 and free H2; H1 takes over H2's node chunks */
+PairingHeap* pairing_heap_union(PairingHeap *H1, PairingHeap *H2) {
+    H1->root = meld(H1->root, H2->root);
+    H1->n += H2->n;
+
+    if (H2->chunks != NULL) {
+        if (H1->chunks == NULL) {
+            H1->chunks = H2->chunks;
+            H1->used = H2->used;
+        } else {
+            /* keep H1's partially used chunk at the head */
+            PairingChunk *tail = H2->chunks;
+            while (tail->next != NULL)
+                tail = tail->next;
+            tail->next = H1->chunks->next;
+            H1->chunks->next = H2->chunks;
+        }
+    }
+
+    while (H2->free_list != NULL) {
+        PairingNode *x = H2->free_list;
+        H2->free_list = x->next;
+        pairing_heap_release(H1, x);
+    }
+
+    free(H2->pairs);
+    free(H2);
+    return H1;
+}
+
+/* ============================
+   FREE HEAP
+   ============================ */
+void pairing_heap_free(PairingHeap *H) {
+    PairingChunk *c = H->chunks;
+    while (c != NULL) {
+        PairingChunk *next = c->next;
+        free(c);
+        c = next;
+    }
+    free(H->pairs);
+    free(H);
+}
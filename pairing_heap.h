@@ -0,0 +1,54 @@
+#ifndef PAIRING_HEAP_H
+#define PAIRING_HEAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Pairing heap: a single heap-ordered tree in child/sibling form.
+   prev points at the left sibling, or at the parent for a first child. */
+typedef struct PairingNode {
+    int key;
+    int id;
+    struct PairingNode *child;
+    struct PairingNode *next;
+    struct PairingNode *prev;
+} PairingNode;
+
+typedef struct PairingChunk {
+    struct PairingChunk *next;
+    int capacity;
+    PairingNode nodes[];
+} PairingChunk;
+
+typedef struct PairingHeap {
+    PairingNode *root;
+    int n;
+
+    /* node pool */
+    PairingChunk *chunks;
+    int used;
+    PairingNode *free_list;     /* linked through ->next */
+
+    /* two-pass merge scratch */
+    PairingNode **pairs;
+    int pairs_cap;
+} PairingHeap;
+
+/* Creation */
+PairingHeap* make_pairing_heap();
+
+/* Operations */
+PairingNode* pairing_heap_insert(PairingHeap *H, int key, int id);
+PairingNode* pairing_heap_min(PairingHeap *H);
+PairingHeap* pairing_heap_union(PairingHeap *H1, PairingHeap *H2);
+PairingNode* pairing_heap_extract_min(PairingHeap *H);
+int pairing_heap_decrease_key(PairingHeap *H, PairingNode *x, int k);
+void pairing_heap_delete(PairingHeap *H, PairingNode *x);
+
+/* Utility */
+void pairing_heap_free(PairingHeap *H);
+
+/* Memory: give back a node returned by pairing_heap_extract_min */
+void pairing_heap_release(PairingHeap *H, PairingNode *x);
+
+#endif
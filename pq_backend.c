@@ -0,0 +1,246 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pq_backend.h"
+#include "modified_fib_heap.h"
+#include "pairing_heap.h"
+#include "dary_heap.h"
+#include "radix_heap.h"
+
+/* ============================
+   FIBONACCI HEAP BACKEND
+   ============================ */
+static void* fib_create(void) {
+    return make_fib_heap();
+}
+
+static PQHandle fib_insert(void *H, int key, int id) {
+    return fib_heap_insert_with_id((FibHeap*)H, key, id);
+}
+
+static int fib_min(void *H, int *key, int *id) {
+    FibNode *x = fib_heap_min((FibHeap*)H);
+    if (x == NULL)
+        return 0;
+    *key = x->key;
+    *id = x->id;
+    return 1;
+}
+
+static int fib_extract_min(void *H, int *key, int *id) {
+    FibNode *x = fib_heap_extract_min((FibHeap*)H);
+    if (x == NULL)
+        return 0;
+    *key = x->key;
+    *id = x->id;
+    fib_heap_release_node((FibHeap*)H, x);
+    return 1;
+}
+
+static int fib_decrease_key(void *H, PQHandle x, int k) {
+    return fib_heap_decrease_key((FibHeap*)H, (FibNode*)x, k);
+}
+
+static void fib_remove(void *H, PQHandle x) {
+    fib_heap_delete((FibHeap*)H, (FibNode*)x);
+}
+
+static void* fib_merge(void *H1, void *H2) {
+    return fib_heap_union((FibHeap*)H1, (FibHeap*)H2);
+}
+
+static int fib_size(void *H) {
+    return ((FibHeap*)H)->n;
+}
+
+static void fib_destroy(void *H) {
+    fib_heap_free((FibHeap*)H);
+}
+
+const PQBackend pq_fib_backend = {
+    "fib", fib_create, fib_insert, fib_min, fib_extract_min,
+    fib_decrease_key, fib_remove, fib_merge, fib_size, fib_destroy
+};
+
+/* ============================
+   PAIRING HEAP BACKEND
+   ============================ */
+static void* pairing_create(void) {
+    return make_pairing_heap();
+}
+
+static PQHandle pairing_insert(void *H, int key, int id) {
+    return pairing_heap_insert((PairingHeap*)H, key, id);
+}
+
+static int pairing_min(void *H, int *key, int *id) {
+    PairingNode *x = pairing_heap_min((PairingHeap*)H);
+    if (x == NULL)
+        return 0;
+    *key = x->key;
+    *id = x->id;
+    return 1;
+}
+
+static int pairing_extract_min(void *H, int *key, int *id) {
+    PairingNode *x = pairing_heap_extract_min((PairingHeap*)H);
+    if (x == NULL)
+        return 0;
+    *key = x->key;
+    *id = x->id;
+    pairing_heap_release((PairingHeap*)H, x);
+    return 1;
+}
+
+static int pairing_decrease_key(void *H, PQHandle x, int k) {
+    return pairing_heap_decrease_key((PairingHeap*)H, (PairingNode*)x, k);
+}
+
+static void pairing_remove(void *H, PQHandle x) {
+    pairing_heap_delete((PairingHeap*)H, (PairingNode*)x);
+}
+
+static void* pairing_merge(void *H1, void *H2) {
+    return pairing_heap_union((PairingHeap*)H1, (PairingHeap*)H2);
+}
+
+static int pairing_size(void *H) {
+    return ((PairingHeap*)H)->n;
+}
+
+static void pairing_destroy(void *H) {
+    pairing_heap_free((PairingHeap*)H);
+}
+
+const PQBackend pq_pairing_backend = {
+    "pairing", pairing_create, pairing_insert, pairing_min, pairing_extract_min,
+    pairing_decrease_key, pairing_remove, pairing_merge, pairing_size, pairing_destroy
+};
+
+/* ============================
+   4-ARY HEAP BACKEND
+   ============================
+   Entries move inside the array, so the handle is the id itself,
+   stored as id + 1 to keep it non-NULL. */
+#define DARY_HANDLE(id) ((PQHandle)((size_t)(id) + 1))
+#define DARY_ID(x)      ((int)((size_t)(x) - 1))
+
+static void* dary_create(void) {
+    return make_dary_heap();
+}
+
+static PQHandle dary_insert(void *H, int key, int id) {
+    if (dary_heap_insert((DaryHeap*)H, key, id) != 0)
+        return NULL;
+    return DARY_HANDLE(id);
+}
+
+static int dary_min(void *H, int *key, int *id) {
+    return dary_heap_min((DaryHeap*)H, key, id);
+}
+
+static int dary_extract_min(void *H, int *key, int *id) {
+    return dary_heap_extract_min((DaryHeap*)H, key, id);
+}
+
+static int dary_decrease_key(void *H, PQHandle x, int k) {
+    return dary_heap_decrease_key((DaryHeap*)H, DARY_ID(x), k);
+}
+
+static void dary_remove(void *H, PQHandle x) {
+    dary_heap_delete((DaryHeap*)H, DARY_ID(x));
+}
+
+static void* dary_merge(void *H1, void *H2) {
+    return dary_heap_union((DaryHeap*)H1, (DaryHeap*)H2);
+}
+
+static int dary_size(void *H) {
+    return ((DaryHeap*)H)->n;
+}
+
+static void dary_destroy(void *H) {
+    dary_heap_free((DaryHeap*)H);
+}
+
+const PQBackend pq_dary_backend = {
+    "dary", dary_create, dary_insert, dary_min, dary_extract_min,
+    dary_decrease_key, dary_remove, dary_merge, dary_size, dary_destroy
+};
+
+/* ============================
+   RADIX HEAP BACKEND
+   ============================
+   Monotone: insert returns NULL and decrease_key -1 for keys below the
+   last extracted minimum. */
+static void* radix_create(void) {
+    return make_radix_heap();
+}
+
+static PQHandle radix_insert(void *H, int key, int id) {
+    return radix_heap_insert((RadixHeap*)H, key, id);
+}
+
+static int radix_min(void *H, int *key, int *id) {
+    RadixNode *x = radix_heap_min((RadixHeap*)H);
+    if (x == NULL)
+        return 0;
+    *key = x->key;
+    *id = x->id;
+    return 1;
+}
+
+static int radix_extract_min(void *H, int *key, int *id) {
+    RadixNode *x = radix_heap_extract_min((RadixHeap*)H);
+    if (x == NULL)
+        return 0;
+    *key = x->key;
+    *id = x->id;
+    radix_heap_release((RadixHeap*)H, x);
+    return 1;
+}
+
+static int radix_decrease_key(void *H, PQHandle x, int k) {
+    return radix_heap_decrease_key((RadixHeap*)H, (RadixNode*)x, k);
+}
+
+static void radix_remove(void *H, PQHandle x) {
+    radix_heap_delete((RadixHeap*)H, (RadixNode*)x);
+}
+
+static void* radix_merge(void *H1, void *H2) {
+    return radix_heap_union((RadixHeap*)H1, (RadixHeap*)H2);
+}
+
+static int radix_size(void *H) {
+    return ((RadixHeap*)H)->n;
+}
+
+static void radix_destroy(void *H) {
+    radix_heap_free((RadixHeap*)H);
+}
+
+const PQBackend pq_radix_backend = {
+    "radix", radix_create, radix_insert, radix_min, radix_extract_min,
+    radix_decrease_key, radix_remove, radix_merge, radix_size, radix_destroy
+};
+
+/* ============================
+   SELECTION
+   ============================ */
+const PQBackend *const pq_backends[] = {
+    &pq_fib_backend,
+    &pq_pairing_backend,
+    &pq_dary_backend,
+    &pq_radix_backend,
+    NULL
+};
+
+const PQBackend* pq_backend_by_name(const char *name) {
+    for (int i = 0; pq_backends[i] != NULL; i++) {
+        if (strcmp(pq_backends[i]->name, name) == 0)
+            return pq_backends[i];
+    }
+    return NULL;
+}
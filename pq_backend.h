@@ -0,0 +1,42 @@
+#ifndef PQ_BACKEND_H
+#define PQ_BACKEND_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Priority-queue backend interface, mirroring modified_fib_heap.h.
+   Items carry an int key and a non-negative id that is unique within a
+   heap. insert returns an opaque handle, valid until the item leaves the
+   heap, for decrease_key and remove. */
+typedef void *PQHandle;
+
+typedef struct PQBackend {
+    const char *name;
+    void* (*create)(void);
+    PQHandle (*insert)(void *H, int key, int id);
+    int (*min)(void *H, int *key, int *id);             /* 0 if empty */
+    int (*extract_min)(void *H, int *key, int *id);     /* 0 if empty */
+    int (*decrease_key)(void *H, PQHandle x, int k);    /* 0, or -1 if k is larger */
+    void (*remove)(void *H, PQHandle x);
+    void* (*merge)(void *H1, void *H2);                 /* consumes both, or NULL keeps both */
+    int (*size)(void *H);
+    void (*destroy)(void *H);
+} PQBackend;
+
+extern const PQBackend pq_fib_backend;
+extern const PQBackend pq_pairing_backend;
+extern const PQBackend pq_dary_backend;
+extern const PQBackend pq_radix_backend;    /* monotone keys only */
+
+/* NULL-terminated list of all backends */
+extern const PQBackend *const pq_backends[];
+
+/* Runtime selection; returns NULL for an unknown name */
+const PQBackend* pq_backend_by_name(const char *name);
+
+/* Compile-time selection: -DPQ_BACKEND_DEFAULT=pq_pairing_backend etc. */
+#ifndef PQ_BACKEND_DEFAULT
+#define PQ_BACKEND_DEFAULT pq_fib_backend
+#endif
+
+#endif
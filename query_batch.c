@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "query_batch.h"
+
+typedef struct QueryResult {
+    int dist;
+    QueryStats stats;
+    int ready;          /* guarded by QueryRun.lock */
+} QueryResult;
+
+/* Shared state of one query_engine_run call */
+typedef struct QueryRun {
+    QueryEngine *E;
+    const QueryPair *q;
+    int count;
+    atomic_int next_query;  /* next index to hand out */
+    QueryResult *results;
+    int next_emit;          /* first index not yet passed to the sink */
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+} QueryRun;
+
+typedef struct QueryWorker {
+    pthread_t thread;
+    QueryRun *run;
+    QueryWorkspace *W;
+} QueryWorker;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* ============================
+   BASIC CREATION FUNCTIONS
+   ============================ */
+QueryEngine* make_query_engine(const Graph *G, const Graph *Gr, int threads) {
+    if (threads < 1)
+        threads = 1;
+
+    QueryEngine *E = (QueryEngine*)malloc(sizeof(QueryEngine));
+    E->G = G;
+    E->Gr = Gr;
+    E->threads = threads;
+    E->workspaces = (QueryWorkspace**)malloc(threads * sizeof(QueryWorkspace*));
+    for (int i = 0; i < threads; i++)
+        E->workspaces[i] = make_query_workspace(G, Gr);
+    return E;
+}
+
+/* ============================
+   WORKERS
+   ============================ */
+static void* worker_main(void *arg) {
+    QueryWorker *w = (QueryWorker*)arg;
+    QueryRun *R = w->run;
+
+    for (;;) {
+        int i = atomic_fetch_add_explicit(&R->next_query, 1, memory_order_relaxed);
+        if (i >= R->count)
+            break;
+
+        QueryResult *res = &R->results[i];
+        if (R->E->Gr)
+            res->dist = query_workspace_bidir(w->W, R->q[i].s, R->q[i].t, &res->stats);
+        else
+            res->dist = query_workspace_to(w->W, R->q[i].s, R->q[i].t, &res->stats);
+
+        pthread_mutex_lock(&R->lock);
+        res->ready = 1;
+        if (i == R->next_emit)
+            pthread_cond_signal(&R->ready);
+        pthread_mutex_unlock(&R->lock);
+    }
+    return NULL;
+}
+
+/* ============================
+   RUN A BATCH
+   ============================
+   The calling thread only streams results: it waits for the next index
+   in order and hands it to the sink while the workers keep going. */
+double query_engine_run(QueryEngine *E, const QueryPair *q, int count, QuerySink sink, void *ctx) {
+    if (count <= 0)
+        return 0;
+
+    QueryRun R;
+    R.E = E;
+    R.q = q;
+    R.count = count;
+    atomic_init(&R.next_query, 0);
+    R.results = (QueryResult*)calloc(count, sizeof(QueryResult));
+    R.next_emit = 0;
+    pthread_mutex_init(&R.lock, NULL);
+    pthread_cond_init(&R.ready, NULL);
+
+    QueryWorker *workers = (QueryWorker*)malloc(E->threads * sizeof(QueryWorker));
+    double t0 = now_seconds();
+
+    for (int i = 0; i < E->threads; i++) {
+        workers[i].run = &R;
+        workers[i].W = E->workspaces[i];
+        pthread_create(&workers[i].thread, NULL, worker_main, &workers[i]);
+    }
+
+    pthread_mutex_lock(&R.lock);
+    while (R.next_emit < count) {
+        QueryResult *res = &R.results[R.next_emit];
+        if (!res->ready) {
+            pthread_cond_wait(&R.ready, &R.lock);
+            continue;
+        }
+
+        int i = R.next_emit++;
+        if (sink) {
+            pthread_mutex_unlock(&R.lock);
+            sink(i, &q[i], res->dist, &res->stats, ctx);
+            pthread_mutex_lock(&R.lock);
+        }
+    }
+    pthread_mutex_unlock(&R.lock);
+
+    for (int i = 0; i < E->threads; i++)
+        pthread_join(workers[i].thread, NULL);
+    double elapsed = now_seconds() - t0;
+
+    free(workers);
+    pthread_cond_destroy(&R.ready);
+    pthread_mutex_destroy(&R.lock);
+    free(R.results);
+    return elapsed > 0 ? count / elapsed : 0;
+}
+
+/* ============================
+   FREE
+   ============================ */
+void query_engine_free(QueryEngine *E) {
+    for (int i = 0; i < E->threads; i++)
+        query_workspace_free(E->workspaces[i]);
+    free(E->workspaces);
+    free(E);
+}
@@ -0,0 +1,36 @@
+#ifndef QUERY_BATCH_H
+#define QUERY_BATCH_H
+
+#include "dijkstra.h"
+
+/* Batch engine for many point-to-point queries on one graph. Each worker
+   keeps its own QueryWorkspace across queries and batches, so no heap or
+   distance array is allocated or cleared per query. */
+typedef struct QueryPair {
+    int s;
+    int t;
+} QueryPair;
+
+/* Called from the thread running query_engine_run, once per query, in
+   the order of the input list. dist is as returned by dijkstra_to. */
+typedef void (*QuerySink)(int index, const QueryPair *q, int dist, const QueryStats *stats, void *ctx);
+
+typedef struct QueryEngine {
+    const Graph *G;
+    const Graph *Gr;        /* non-NULL selects bidirectional search */
+    int threads;
+    QueryWorkspace **workspaces;
+} QueryEngine;
+
+/* Creation */
+QueryEngine* make_query_engine(const Graph *G, const Graph *Gr, int threads);
+
+/* Runs count queries on the worker threads and streams results to sink
+   (which may be NULL) as soon as they are ready in order. Returns the
+   throughput in queries per second. */
+double query_engine_run(QueryEngine *E, const QueryPair *q, int count, QuerySink sink, void *ctx);
+
+/* Utility */
+void query_engine_free(QueryEngine *E);
+
+#endif
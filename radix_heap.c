@@ -0,0 +1,222 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "radix_heap.h"
+
+#define RADIX_CHUNK_MIN 64
+#define RADIX_CHUNK_MAX 65536
+
+/* ============================
+   BASIC CREATION FUNCTIONS
+   ============================ */
+RadixHeap* make_radix_heap() {
+    RadixHeap *H = (RadixHeap*)malloc(sizeof(RadixHeap));
+    H->last = 0;
+    H->n = 0;
+    for (int b = 0; b < RADIX_BUCKETS; b++) {
+        H->buckets[b].a = NULL;
+        H->buckets[b].n = 0;
+        H->buckets[b].cap = 0;
+    }
+    H->chunks = NULL;
+    H->used = 0;
+    H->spare = NULL;
+    H->spare_n = 0;
+    H->spare_cap = 0;
+    return H;
+}
+
+static RadixNode* alloc_node(RadixHeap *H) {
+    if (H->spare_n > 0)
+        return H->spare[--H->spare_n];
+
+    if (H->chunks == NULL || H->used == H->chunks->capacity) {
+        int cap = RADIX_CHUNK_MIN;
+        if (H->chunks != NULL) {
+            cap = H->chunks->capacity * 2;
+            if (cap > RADIX_CHUNK_MAX)
+                cap = RADIX_CHUNK_MAX;
+        }
+        RadixChunk *c = (RadixChunk*)malloc(sizeof(RadixChunk) + (size_t)cap * sizeof(RadixNode));
+        c->capacity = cap;
+        c->next = H->chunks;
+        H->chunks = c;
+        H->used = 0;
+    }
+
+    return &H->chunks->nodes[H->used++];
+}
+
+void radix_heap_release(RadixHeap *H, RadixNode *x) {
+    if (H->spare_n == H->spare_cap) {
+        H->spare_cap = H->spare_cap ? H->spare_cap * 2 : 64;
+        H->spare = (RadixNode**)realloc(H->spare, H->spare_cap * sizeof(RadixNode*));
+    }
+    H->spare[H->spare_n++] = x;
+}
+
+/* ============================
+   BUCKETS
+   ============================ */
+static int bucket_of(int last, int key) {
+    unsigned int diff = (unsigned int)key ^ (unsigned int)last;
+    if (diff == 0)
+        return 0;
+    return 32 - __builtin_clz(diff);
+}
+
+static void bucket_push(RadixHeap *H, RadixNode *x) {
+    RadixBucket *B = &H->buckets[bucket_of(H->last, x->key)];
+    if (B->n == B->cap) {
+        B->cap = B->cap ? B->cap * 2 : 16;
+        B->a = (RadixNode**)realloc(B->a, B->cap * sizeof(RadixNode*));
+    }
+    x->bucket = (int)(B - H->buckets);
+    x->slot = B->n;
+    B->a[B->n++] = x;
+}
+
+/* O(1): move the bucket's last node into x's slot */
+static void bucket_remove(RadixHeap *H, RadixNode *x) {
+    RadixBucket *B = &H->buckets[x->bucket];
+    RadixNode *tail = B->a[--B->n];
+    B->a[x->slot] = tail;
+    tail->slot = x->slot;
+}
+
+/* Make bucket 0 non-empty: raise `last` to the smallest key of the first
+   non-empty bucket and redistribute that bucket. Each node only moves to
+   a lower bucket, which bounds the total work by O(log C) per node. */
+static void refill(RadixHeap *H) {
+    if (H->buckets[0].n > 0 || H->n == 0)
+        return;
+
+    int b = 1;
+    while (H->buckets[b].n == 0)
+        b++;
+
+    RadixBucket *B = &H->buckets[b];
+    int m = B->a[0]->key;
+    for (int i = 1; i < B->n; i++) {
+        if (B->a[i]->key < m)
+            m = B->a[i]->key;
+    }
+
+    H->last = m;
+    int count = B->n;
+    B->n = 0;
+    for (int i = 0; i < count; i++)
+        bucket_push(H, B->a[i]);
+}
+
+/* ============================
+   OPERATIONS
+   ============================ */
+RadixNode* radix_heap_insert(RadixHeap *H, int key, int id) {
+    if (key < H->last)
+        return NULL;
+
+    RadixNode *x = alloc_node(H);
+    x->key = key;
+    x->id = id;
+    bucket_push(H, x);
+    H->n++;
+    return x;
+}
+
+RadixNode* radix_heap_min(RadixHeap *H) {
+    refill(H);
+    return H->n > 0 ? H->buckets[0].a[0] : NULL;
+}
+
+RadixNode* radix_heap_extract_min(RadixHeap *H) {
+    RadixNode *z = radix_heap_min(H);
+    if (z == NULL)
+        return NULL;
+
+    bucket_remove(H, z);
+    H->n--;
+    return z;
+}
+
+/* Returns 0, or -1 if k is larger than the current key or below `last` */
+int radix_heap_decrease_key(RadixHeap *H, RadixNode *x, int k) {
+    if (k > x->key || k < H->last)
+        return -1;
+
+    x->key = k;
+    bucket_remove(H, x);
+    bucket_push(H, x);
+    return 0;
+}
+
+void radix_heap_delete(RadixHeap *H, RadixNode *x) {
+    bucket_remove(H, x);
+    H->n--;
+    radix_heap_release(H, x);
+}
+
+/* ============================
+   UNION OF TWO HEAPS
+   ============================
+   The result is bounded below by the smaller of the two `last` values.
+   H1 is rebucketed if its bound drops, then H2's nodes are pushed in.
+   H1 takes over H2's node chunks, so handles stay valid. H2 is freed. */
+RadixHeap* radix_heap_union(RadixHeap *H1, RadixHeap *H2) {
+    if (H2->last < H1->last) {
+        H1->last = H2->last;
+        for (int b = 0; b < RADIX_BUCKETS; b++) {
+            RadixBucket *B = &H1->buckets[b];
+            int count = B->n;
+            B->n = 0;
+            for (int i = 0; i < count; i++)
+                bucket_push(H1, B->a[i]);
+        }
+    }
+
+    for (int b = 0; b < RADIX_BUCKETS; b++) {
+        RadixBucket *B = &H2->buckets[b];
+        for (int i = 0; i < B->n; i++)
+            bucket_push(H1, B->a[i]);
+        free(B->a);
+    }
+    H1->n += H2->n;
+
+    if (H2->chunks != NULL) {
+        if (H1->chunks == NULL) {
+            H1->chunks = H2->chunks;
+            H1->used = H2->used;
+        } else {
+            /* keep H1's partially used chunk at the head */
+            RadixChunk *tail = H2->chunks;
+            while (tail->next != NULL)
+                tail = tail->next;
+            tail->next = H1->chunks->next;
+            H1->chunks->next = H2->chunks;
+        }
+    }
+
+    for (int i = 0; i < H2->spare_n; i++)
+        radix_heap_release(H1, H2->spare[i]);
+
+    free(H2->spare);
+    free(H2);
+    return H1;
+}
+
+/* ============================
+   FREE HEAP
+   ============================ */
+void radix_heap_free(RadixHeap *H) {
+    for (int b = 0; b < RADIX_BUCKETS; b++)
+        free(H->buckets[b].a);
+
+    RadixChunk *c = H->chunks;
+    while (c != NULL) {
+        RadixChunk *next = c->next;
+        free(c);
+        c = next;
+    }
+    free(H->spare);
+    free(H);
+}
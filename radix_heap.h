@@ -0,0 +1,63 @@
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Radix heap: a monotone priority queue for non-negative int keys. Every
+   key must be >= the last extracted minimum (`last`). Bucket 0 holds keys
+   equal to `last`, and bucket b > 0 holds keys whose highest bit differing
+   from `last` is bit b - 1. Buckets are arrays of node pointers, and a node
+   remembers its bucket and slot, so removal is a swap with the last slot. */
+#define RADIX_BUCKETS 32      /* keys are non-negative, so at most 31 differing bits */
+
+typedef struct RadixNode {
+    int key;
+    int id;
+    int bucket;
+    int slot;
+} RadixNode;
+
+typedef struct RadixBucket {
+    RadixNode **a;
+    int n;
+    int cap;
+} RadixBucket;
+
+typedef struct RadixChunk {
+    struct RadixChunk *next;
+    int capacity;
+    RadixNode nodes[];
+} RadixChunk;
+
+typedef struct RadixHeap {
+    int last;           /* last extracted key; lower bound on every key */
+    int n;
+    RadixBucket buckets[RADIX_BUCKETS];
+
+    /* node pool */
+    RadixChunk *chunks;
+    int used;
+    RadixNode **spare;      /* released nodes, used as a stack */
+    int spare_n;
+    int spare_cap;
+} RadixHeap;
+
+/* Creation */
+RadixHeap* make_radix_heap();
+
+/* Operations: insert returns NULL if key < last */
+RadixNode* radix_heap_insert(RadixHeap *H, int key, int id);
+RadixNode* radix_heap_min(RadixHeap *H);
+RadixHeap* radix_heap_union(RadixHeap *H1, RadixHeap *H2);
+RadixNode* radix_heap_extract_min(RadixHeap *H);
+int radix_heap_decrease_key(RadixHeap *H, RadixNode *x, int k);
+void radix_heap_delete(RadixHeap *H, RadixNode *x);
+
+/* Utility */
+void radix_heap_free(RadixHeap *H);
+
+/* Memory: give back a node returned by radix_heap_extract_min */
+void radix_heap_release(RadixHeap *H, RadixNode *x);
+
+#endif
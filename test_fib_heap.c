@@ -0,0 +1,723 @@
+/* ============================
+   FIBONACCI HEAP TESTS
+   ============================
+   Assertion checks for modified_fib_heap.c. Exits non-zero on the first
+   failure. Build and run each heap variant, including the stdio snapshot
+   loader:
+
+     gcc -O2 -DFIB_HEAP_NO_MAIN test_fib_heap.c modified_fib_heap.c -lm -o test_fib_heap
+     gcc -O2 -DFIB_HEAP_NO_MAIN -DFIB_HEAP_NO_POOL test_fib_heap.c modified_fib_heap.c -lm -o test_fib_heap_malloc
+     gcc -O2 -DFIB_HEAP_NO_MAIN -DFIB_HEAP_NO_MMAP test_fib_heap.c modified_fib_heap.c -lm -o test_fib_heap_stdio
+
+   Usage: ./test_fib_heap
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "modified_fib_heap.h"
+
+#define CHECK(c)                                                        \
+    do {                                                                \
+        if (!(c)) {                                                     \
+            fprintf(stderr, "%s:%d: check failed: %s\n",                \
+                    __FILE__, __LINE__, #c);                            \
+            exit(1);                                                    \
+        }                                                               \
+    } while (0)
+
+static unsigned int rng = 12345;
+
+static int next_rand(void) {
+    rng = rng * 1103515245u + 12345u;
+    return (int)((rng >> 8) & 0x7FFFFF);
+}
+
+/* Live handles mirrored outside the heap, so min and n can be checked */
+#define MODEL_MAX 4096
+
+typedef struct Model {
+    FibNode *live[MODEL_MAX];
+    int n;
+} Model;
+
+static void model_remove(Model *M, FibNode *x) {
+    for (int i = 0; i < M->n; i++) {
+        if (M->live[i] == x) {
+            M->live[i] = M->live[--M->n];
+            return;
+        }
+    }
+    CHECK(!"node not in model");
+}
+
+static void model_check(FibHeap *H, Model *M) {
+    CHECK(H->n == M->n);
+    if (M->n == 0) {
+        CHECK(H->min == NULL);
+        return;
+    }
+
+    int best = INT_MAX;
+    for (int i = 0; i < M->n; i++)
+        if (M->live[i]->key < best)
+            best = M->live[i]->key;
+    CHECK(H->min != NULL && !H->min->dead && H->min->key == best);
+}
+
+/* Drain H, checking ascending order and that every live node comes out */
+static void drain_sorted(FibHeap *H, Model *M) {
+    int last = INT_MIN;
+    while (H->n > 0) {
+        FibNode *x = fib_heap_extract_min(H);
+        CHECK(x != NULL && !x->dead && x->key >= last);
+        last = x->key;
+        model_remove(M, x);
+        fib_heap_release_node(H, x);
+    }
+    CHECK(M->n == 0);
+    CHECK(H->min == NULL && H->n_dead == 0);
+}
+
+/* ============================
+   LAZY DELETE
+   ============================ */
+static void test_delete_accounting(void) {
+    FibHeap *H = make_fib_heap();
+    FibNode *x[8];
+    for (int i = 0; i < 8; i++)
+        x[i] = fib_heap_insert(H, 10 * i);
+    fib_heap_release_node(H, fib_heap_extract_min(H));   /* builds trees */
+
+    /* a non-min node becomes a tombstone */
+    fib_heap_delete(H, x[5]);
+    CHECK(H->n == 6 && H->n_dead == 1);
+    CHECK(H->min == x[1]);
+
+    /* deleting it again changes nothing */
+    fib_heap_delete(H, x[5]);
+    CHECK(H->n == 6 && H->n_dead == 1);
+
+    /* deleting the min extracts it and purges dead roots on the way */
+    fib_heap_delete(H, x[1]);
+    CHECK(H->n == 5 && H->min == x[2]);
+
+    fib_heap_purge(H);
+    CHECK(H->n_dead == 0 && H->n == 5);
+
+    int expect[] = { 20, 30, 40, 60, 70 };
+    for (int i = 0; i < 5; i++) {
+        FibNode *m = fib_heap_extract_min(H);
+        CHECK(m->key == expect[i]);
+        fib_heap_release_node(H, m);
+    }
+    CHECK(H->min == NULL && H->n == 0 && H->n_dead == 0);
+    fib_heap_free(H);
+}
+
+static void test_delete_int_min_key(void) {
+    FibHeap *H = make_fib_heap();
+    FibNode *a = fib_heap_insert(H, INT_MIN);
+    FibNode *b = fib_heap_insert(H, INT_MIN);
+    fib_heap_insert(H, 5);
+
+    /* real INT_MIN keys must not be confused with a delete sentinel */
+    fib_heap_delete(H, b == H->min ? a : b);
+    CHECK(H->n == 2 && H->min->key == INT_MIN);
+    FibNode *m = fib_heap_extract_min(H);
+    CHECK(m->key == INT_MIN);
+    fib_heap_release_node(H, m);
+    CHECK(H->min->key == 5);
+    fib_heap_free(H);
+}
+
+static void test_delete_by_id(void) {
+    FibHeap *H = make_fib_heap();
+    for (int i = 0; i < 100; i++)
+        fib_heap_insert_with_id(H, 1000 - i, i);
+    fib_heap_release_node(H, fib_heap_extract_min(H));
+
+    CHECK(fib_heap_delete_by_id(H, 10) == 0);
+    CHECK(fib_heap_find_by_id(H, 10) == NULL);
+    CHECK(fib_heap_delete_by_id(H, 10) == -1);
+    CHECK(H->n == 98);
+
+    /* the id is free again while the tombstone is still linked */
+    CHECK(fib_heap_insert_with_id(H, 1, 10) != NULL);
+    CHECK(H->min->key == 1 && H->min->id == 10);
+    fib_heap_free(H);
+}
+
+static void test_delete_threshold_purge(void) {
+    FibHeap *H = make_fib_heap();
+    Model M = { {0}, 0 };
+    for (int i = 0; i < 1000; i++)
+        M.live[M.n++] = fib_heap_insert(H, next_rand() % 5000);
+    FibNode *m = fib_heap_extract_min(H);
+    model_remove(&M, m);
+    fib_heap_release_node(H, m);
+
+    /* delete non-min nodes until the dead would outnumber the live */
+    int seen_dead = 0;
+    while (M.n > 300) {
+        FibNode *x = M.live[next_rand() % M.n];
+        if (x == H->min)
+            continue;
+        model_remove(&M, x);
+        fib_heap_delete(H, x);
+        model_check(H, &M);
+        CHECK(H->n_dead <= H->n || H->n_dead < 64);
+        if (H->n_dead > seen_dead)
+            seen_dead = H->n_dead;
+    }
+    CHECK(seen_dead >= 64);
+    drain_sorted(H, &M);
+    fib_heap_free(H);
+}
+
+/* Random mix of every mutating operation against the model */
+static void test_delete_random_mix(void) {
+    for (int round = 0; round < 20; round++) {
+        FibHeap *H = make_fib_heap();
+        Model M = { {0}, 0 };
+
+        for (int step = 0; step < 5000; step++) {
+            int op = next_rand() % 100;
+            if (op < 40 && M.n < MODEL_MAX) {
+                M.live[M.n++] = fib_heap_insert(H, next_rand() % 1000 - 500);
+            } else if (op < 75 && M.n > 0) {
+                int i = next_rand() % M.n;
+                FibNode *x = M.live[i];
+                M.live[i] = M.live[--M.n];
+                fib_heap_delete(H, x);
+            } else if (op < 88 && M.n > 0) {
+                FibNode *x = fib_heap_extract_min(H);
+                model_remove(&M, x);
+                fib_heap_release_node(H, x);
+            } else if (op < 96 && M.n > 0) {
+                FibNode *out[8];
+                int k = fib_heap_extract_k(H, 1 + next_rand() % 8, out);
+                for (int j = 0; j < k; j++) {
+                    CHECK(!out[j]->dead);
+                    CHECK(j == 0 || out[j - 1]->key <= out[j]->key);
+                    model_remove(&M, out[j]);
+                }
+                for (int j = 0; j < k; j++)
+                    fib_heap_release_node(H, out[j]);
+            } else if (M.n > 0) {
+                FibNode *x = M.live[next_rand() % M.n];
+                fib_heap_decrease_key(H, x, x->key - next_rand() % 50);
+            }
+            model_check(H, &M);
+        }
+
+        drain_sorted(H, &M);
+        fib_heap_free(H);
+    }
+}
+
+/* ============================
+   CHANGING KEYS
+   ============================ */
+static void test_decrease_key_codes(void) {
+    FibHeap *H = make_fib_heap();
+    FibNode *a = fib_heap_insert(H, 10);
+    FibNode *b = fib_heap_insert(H, 20);
+
+    CHECK(fib_heap_decrease_key(H, b, 25) == -1);   /* increase */
+    CHECK(b->key == 20 && H->min == a);
+    CHECK(fib_heap_decrease_key(H, b, 20) == 0);    /* equal */
+    CHECK(b->key == 20 && H->min == a);
+    CHECK(fib_heap_decrease_key(H, b, 5) == 0);     /* decrease */
+    CHECK(b->key == 5 && H->min == b && H->n == 2);
+
+    CHECK(fib_heap_insert_with_id(H, 30, 7) != NULL);
+    CHECK(fib_heap_decrease_key_by_id(H, 7, 31) == -1);
+    CHECK(fib_heap_decrease_key_by_id(H, 7, 1) == 0);
+    CHECK(H->min->id == 7);
+    CHECK(fib_heap_decrease_key_by_id(H, 8, 0) == -1);
+
+    /* a deleted node refuses every change */
+    fib_heap_delete(H, a);
+    CHECK(fib_heap_decrease_key(H, a, 0) == -1);
+    CHECK(a->key == 10 && H->n == 2);
+    fib_heap_free(H);
+}
+
+static void test_update_key_codes(void) {
+    FibHeap *H = make_fib_heap();
+    FibNode *a = fib_heap_insert(H, 10);
+    FibNode *b = fib_heap_insert(H, 20);
+    FibNode *c = fib_heap_insert(H, 30);
+
+    CHECK(fib_heap_update_key(H, b, 20) == 0);      /* equal */
+    CHECK(b->key == 20 && H->min == a);
+    CHECK(fib_heap_update_key(H, a, 40) == 0);      /* increase the min */
+    CHECK(a->key == 40 && H->min == b && H->n == 3);
+    CHECK(fib_heap_update_key(H, c, 5) == 0);       /* decrease */
+    CHECK(c->key == 5 && H->min == c);
+
+    CHECK(fib_heap_insert_with_id(H, 50, 3) != NULL);
+    CHECK(fib_heap_update_key_by_id(H, 3, 1) == 0);
+    CHECK(H->min->id == 3);
+    CHECK(fib_heap_update_key_by_id(H, 3, 60) == 0);
+    CHECK(H->min == c);
+    CHECK(fib_heap_update_key_by_id(H, 4, 0) == -1);
+
+    fib_heap_delete(H, b);
+    CHECK(fib_heap_update_key(H, b, 100) == -1);
+    CHECK(b->key == 20 && H->n == 3);
+
+    int expect[] = { 5, 40, 60 };
+    for (int i = 0; i < 3; i++) {
+        FibNode *m = fib_heap_extract_min(H);
+        CHECK(m->key == expect[i]);
+        fib_heap_release_node(H, m);
+    }
+    fib_heap_free(H);
+}
+
+/* Increases and decreases on nodes deep in consolidated trees */
+static void test_update_key_random(void) {
+    FibHeap *H = make_fib_heap();
+    Model M = { {0}, 0 };
+    for (int i = 0; i < 2000; i++)
+        M.live[M.n++] = fib_heap_insert(H, next_rand() % 10000);
+
+    for (int step = 0; step < 20000; step++) {
+        if (step % 50 == 0) {
+            FibNode *m = fib_heap_extract_min(H);
+            model_remove(&M, m);
+            fib_heap_release_node(H, m);
+            M.live[M.n++] = fib_heap_insert(H, next_rand() % 10000);
+        }
+        FibNode *x = M.live[next_rand() % M.n];
+        CHECK(fib_heap_update_key(H, x, next_rand() % 10000) == 0);
+        model_check(H, &M);
+    }
+    drain_sorted(H, &M);
+    fib_heap_free(H);
+}
+
+/* ============================
+   PEEK / ORDERED ITERATION
+   ============================ */
+
+/* A heap with trees, marked nodes and tombstones */
+static FibHeap* build_mixed_heap(Model *M) {
+    FibHeap *H = make_fib_heap();
+    M->n = 0;
+    for (int i = 0; i < 3000; i++)
+        M->live[M->n++] = fib_heap_insert(H, next_rand() % 2000);
+    for (int i = 0; i < 10; i++) {
+        FibNode *m = fib_heap_extract_min(H);
+        model_remove(M, m);
+        fib_heap_release_node(H, m);
+    }
+    for (int i = 0; i < 40; i++) {
+        FibNode *x = M->live[next_rand() % M->n];
+        if (x == H->min)
+            continue;
+        model_remove(M, x);
+        fib_heap_delete(H, x);
+    }
+    for (int i = 0; i < 200; i++) {
+        FibNode *x = M->live[next_rand() % M->n];
+        fib_heap_decrease_key(H, x, x->key - next_rand() % 100);
+    }
+    CHECK(H->n_dead > 0);
+    return H;
+}
+
+static void test_peek_k(void) {
+    Model M;
+    FibHeap *H = build_mixed_heap(&M);
+    int n = H->n, n_dead = H->n_dead;
+    FibNode *min = H->min;
+
+    FibNode *out[256];
+    int k = fib_heap_peek_k(H, 256, out);
+    CHECK(k == 256);
+    CHECK(out[0] == min);
+    for (int i = 0; i < k; i++) {
+        CHECK(!out[i]->dead);
+        CHECK(i == 0 || out[i - 1]->key <= out[i]->key);
+    }
+    CHECK(H->n == n && H->n_dead == n_dead && H->min == min);
+
+    /* peek agrees with what extraction then removes */
+    FibNode *ext[256];
+    CHECK(fib_heap_extract_k(H, 256, ext) == 256);
+    for (int i = 0; i < k; i++) {
+        CHECK(ext[i]->key == out[i]->key);
+        model_remove(&M, ext[i]);
+    }
+    for (int i = 0; i < k; i++)
+        fib_heap_release_node(H, ext[i]);
+
+    /* asking for more than n returns n */
+    FibHeap *S = make_fib_heap();
+    CHECK(fib_heap_peek_k(S, 4, out) == 0);
+    fib_heap_insert(S, 3);
+    fib_heap_insert(S, 1);
+    CHECK(fib_heap_peek_k(S, 4, out) == 2);
+    CHECK(out[0]->key == 1 && out[1]->key == 3 && S->n == 2);
+    fib_heap_free(S);
+
+    drain_sorted(H, &M);
+    fib_heap_free(H);
+}
+
+static void test_iter(void) {
+    Model M;
+    FibHeap *H = build_mixed_heap(&M);
+    int n = H->n, n_dead = H->n_dead;
+    FibNode *min = H->min;
+
+    FibHeapIter a, b;
+    fib_heap_iter_init(&a, H);
+    fib_heap_iter_init(&b, H);
+
+    int count = 0, last = INT_MIN;
+    FibNode *x;
+    while ((x = fib_heap_iter_next(&a)) != NULL) {
+        CHECK(!x->dead && x->key >= last);
+        CHECK(count > 0 || x == min);
+        last = x->key;
+        count++;
+
+        /* a second iterator runs independently */
+        if (count % 3 == 0) {
+            FibNode *y = fib_heap_iter_next(&b);
+            CHECK(y != NULL && !y->dead);
+        }
+    }
+    CHECK(count == n);
+    CHECK(fib_heap_iter_next(&a) == NULL);
+    fib_heap_iter_free(&a);
+    fib_heap_iter_free(&b);
+    CHECK(H->n == n && H->n_dead == n_dead && H->min == min);
+
+    FibHeap *E = make_fib_heap();
+    fib_heap_iter_init(&a, E);
+    CHECK(fib_heap_iter_next(&a) == NULL);
+    fib_heap_iter_free(&a);
+    fib_heap_free(E);
+
+    drain_sorted(H, &M);
+    fib_heap_free(H);
+}
+
+/* ============================
+   MELD
+   ============================ */
+
+/* Insert ids first, first + step, ... with random keys, then extract once
+   so the heap has trees rather than a flat root list */
+static FibHeap* build_id_heap(Model *M, int first, int step, int count) {
+    FibHeap *H = make_fib_heap();
+    for (int i = 0; i < count; i++) {
+        FibNode *x = fib_heap_insert_with_id(H, next_rand() % 5000, first + i * step);
+        CHECK(x != NULL);
+        M->live[M->n++] = x;
+    }
+    FibNode *m = fib_heap_extract_min(H);
+    model_remove(M, m);
+    fib_heap_release_node(H, m);
+    return H;
+}
+
+static void test_meld_empty(void) {
+    Model M = { {0}, 0 };
+
+    /* into an empty heap: everything moves, ids included */
+    FibHeap *E = make_fib_heap();
+    FibHeap *H = build_id_heap(&M, 0, 1, 50);
+    fib_heap_meld(E, H);
+    CHECK(H->n == 0 && H->min == NULL && fib_heap_find_by_id(H, 7) == NULL);
+    model_check(E, &M);
+    for (int i = 0; i < M.n; i++)
+        CHECK(fib_heap_find_by_id(E, M.live[i]->id) == M.live[i]);
+
+    /* from an empty heap: nothing changes */
+    FibNode *min = E->min;
+    int n = E->n;
+    fib_heap_meld(E, H);
+    CHECK(E->n == n && E->min == min && H->n == 0);
+
+    /* both empty */
+    FibHeap *F = make_fib_heap();
+    fib_heap_meld(H, F);
+    CHECK(H->n == 0 && H->min == NULL && H->n_dead == 0);
+
+    /* a heap melded into itself is untouched */
+    fib_heap_meld(E, E);
+    CHECK(E->n == n && E->min == min);
+
+    fib_heap_free(F);
+    fib_heap_free(H);
+    drain_sorted(E, &M);
+    fib_heap_free(E);
+}
+
+static void test_meld_ids(void) {
+    Model M = { {0}, 0 };
+
+    /* B's id table is larger than A's, so the tables are swapped */
+    FibHeap *A = build_id_heap(&M, 0, 2, 100);
+    FibHeap *B = build_id_heap(&M, 1, 4, 300);
+
+    /* a tombstone and a node extracted but not yet released move too */
+    FibNode *t = fib_heap_find_by_id(B, 41);
+    CHECK(t != NULL && t != B->min);
+    model_remove(&M, t);
+    fib_heap_delete(B, t);
+    FibNode *held = fib_heap_extract_min(B);
+    model_remove(&M, held);
+
+    fib_heap_meld(A, B);
+    CHECK(A->n_dead == 1 && B->n == 0 && B->n_dead == 0 && B->min == NULL);
+    model_check(A, &M);
+    fib_heap_release_node(A, held);
+
+    /* every moved node is found through the merged index */
+    for (int i = 0; i < M.n; i++) {
+        CHECK(fib_heap_find_by_id(A, M.live[i]->id) == M.live[i]);
+        CHECK(fib_heap_find_by_id(B, M.live[i]->id) == NULL);
+    }
+    CHECK(fib_heap_find_by_id(A, 41) == NULL);
+
+    /* and can be updated by id */
+    FibNode *x = M.live[M.n - 1];   /* came from B */
+    CHECK(fib_heap_decrease_key_by_id(A, x->id, -5) == 0);
+    CHECK(A->min == x && x->key == -5);
+    x = M.live[0];                  /* came from A */
+    int id = x->id;
+    model_remove(&M, x);
+    CHECK(fib_heap_delete_by_id(A, id) == 0);
+    CHECK(fib_heap_find_by_id(A, id) == NULL);
+    model_check(A, &M);
+
+    /* the emptied source is still usable, ids that moved away included */
+    Model N = { {0}, 0 };
+    for (int i = 0; i < 200; i++) {
+        x = fib_heap_insert_with_id(B, next_rand() % 5000, i);
+        CHECK(x != NULL);
+        N.live[N.n++] = x;
+    }
+    FibNode *m = fib_heap_extract_min(B);
+    model_remove(&N, m);
+    fib_heap_release_node(B, m);
+    x = N.live[0];
+    CHECK(fib_heap_decrease_key_by_id(B, x->id, -1) == 0 && B->min == x);
+    model_check(B, &N);
+    drain_sorted(B, &N);
+
+    drain_sorted(A, &M);
+    fib_heap_free(A);
+    fib_heap_free(B);
+}
+
+static void test_meld_many(void) {
+    Model M = { {0}, 0 };
+    FibHeap *H[4];
+    H[0] = build_id_heap(&M, 0, 4, 100);
+    H[1] = build_id_heap(&M, 1, 4, 100);
+    H[2] = build_id_heap(&M, 2, 4, 100);
+    H[3] = make_fib_heap();
+
+    /* NULL entries are skipped; repeats, and heaps[0] itself, meld once */
+    FibHeap *list[] = { H[0], NULL, H[1], H[3], H[1], H[0], NULL, H[2], H[2] };
+    CHECK(fib_heap_meld_many(list, 9) == H[0]);
+    model_check(H[0], &M);
+    for (int i = 1; i < 4; i++)
+        CHECK(H[i]->n == 0 && H[i]->min == NULL);
+    for (int i = 0; i < M.n; i++)
+        CHECK(fib_heap_find_by_id(H[0], M.live[i]->id) == M.live[i]);
+
+    /* a single heap, an empty list and a NULL first entry */
+    CHECK(fib_heap_meld_many(H, 1) == H[0]);
+    model_check(H[0], &M);
+    CHECK(fib_heap_meld_many(H, 0) == NULL);
+    FibHeap *none[] = { NULL, H[1] };
+    CHECK(fib_heap_meld_many(none, 2) == NULL);
+
+    drain_sorted(H[0], &M);
+    for (int i = 0; i < 4; i++)
+        fib_heap_free(H[i]);
+}
+
+/* ============================
+   SNAPSHOTS
+   ============================ */
+#define SNAP_PATH "test_fib_heap.snap"
+
+static long read_file(const char *path, unsigned char **out) {
+    FILE *f = fopen(path, "rb");
+    CHECK(f != NULL);
+    CHECK(fseek(f, 0, SEEK_END) == 0);
+    long len = ftell(f);
+    rewind(f);
+    *out = (unsigned char*)malloc(len > 0 ? len : 1);
+    CHECK(fread(*out, 1, len, f) == (size_t)len);
+    fclose(f);
+    return len;
+}
+
+static void write_file(const char *path, const unsigned char *buf, long len) {
+    FILE *f = fopen(path, "wb");
+    CHECK(f != NULL);
+    CHECK(fwrite(buf, 1, len, f) == (size_t)len);
+    CHECK(fclose(f) == 0);
+}
+
+/* Hand-made snapshot: the 32-byte header, then (key, id, flags) records
+   with flags = degree << 2 | dead << 1 | mark */
+static void write_snapshot(const char *magic, int64_t n, const int32_t *rec, int nrec) {
+    unsigned char buf[32 + 12 * 16];
+    memset(buf, 0, sizeof(buf));
+    memcpy(buf, magic, 8);
+    memcpy(buf + 8, &n, sizeof(n));
+    memcpy(buf + 32, rec, nrec * 3 * sizeof(int32_t));
+    write_file(SNAP_PATH, buf, 32 + 12L * nrec);
+}
+
+static FibHeap* load_snapshot(const int32_t *rec, int nrec) {
+    write_snapshot("FIBSNP2", nrec, rec, nrec);
+    FibHeap *H = fib_heap_load(SNAP_PATH);
+    remove(SNAP_PATH);
+    return H;
+}
+
+static void test_snapshot_round_trip(void) {
+    FibHeap *H = make_fib_heap();
+    for (int i = 0; i < 500; i++)
+        CHECK(fib_heap_insert_with_id(H, next_rand() % 1000, i) != NULL);
+    for (int i = 0; i < 5; i++)
+        fib_heap_release_node(H, fib_heap_extract_min(H));
+    for (int i = 0; i < 60; i++) {
+        FibNode *x = fib_heap_find_by_id(H, next_rand() % 500);
+        if (x != NULL && x != H->min)
+            fib_heap_decrease_key(H, x, x->key - next_rand() % 300);
+    }
+    for (int i = 0; i < 20; i++) {
+        FibNode *x = fib_heap_find_by_id(H, next_rand() % 500);
+        if (x != NULL && x != H->min)
+            fib_heap_delete(H, x);
+    }
+    CHECK(H->n_dead > 0);
+
+    CHECK(fib_heap_save(H, SNAP_PATH) == 0);
+    FibHeap *L = fib_heap_load(SNAP_PATH);
+    CHECK(L != NULL);
+    CHECK(L->n == H->n && L->n_dead == H->n_dead);
+    CHECK(L->min->key == H->min->key && L->min->id == H->min->id);
+    for (int id = 0; id < 500; id++) {
+        FibNode *a = fib_heap_find_by_id(H, id);
+        FibNode *b = fib_heap_find_by_id(L, id);
+        CHECK((a == NULL) == (b == NULL));
+        CHECK(a == NULL || (a->key == b->key && a->degree == b->degree && a->mark == b->mark));
+    }
+
+    /* same forest shape: saving the loaded heap gives the same bytes */
+    unsigned char *first, *second;
+    long len1 = read_file(SNAP_PATH, &first);
+    CHECK(fib_heap_save(L, SNAP_PATH) == 0);
+    long len2 = read_file(SNAP_PATH, &second);
+    CHECK(len1 == len2 && memcmp(first, second, len1) == 0);
+    free(first);
+    free(second);
+    remove(SNAP_PATH);
+
+    /* and the same extraction order */
+    while (H->n > 0) {
+        FibNode *a = fib_heap_extract_min(H);
+        FibNode *b = fib_heap_extract_min(L);
+        CHECK(a->key == b->key && a->id == b->id);
+        fib_heap_release_node(H, a);
+        fib_heap_release_node(L, b);
+    }
+    CHECK(L->n == 0 && L->min == NULL);
+    fib_heap_free(H);
+    fib_heap_free(L);
+
+    /* an empty heap round-trips to an empty heap */
+    H = make_fib_heap();
+    CHECK(fib_heap_save(H, SNAP_PATH) == 0);
+    L = fib_heap_load(SNAP_PATH);
+    remove(SNAP_PATH);
+    CHECK(L != NULL && L->n == 0 && L->min == NULL);
+    fib_heap_free(H);
+    fib_heap_free(L);
+}
+
+static void test_snapshot_rejects(void) {
+    /* a valid three-node file: root 1 (id 0) with child 4 (id 1), root 2 */
+    int32_t ok[] = { 1, 0, 1 << 2,   4, 1, 0,   2, 2, 0 };
+    FibHeap *H = load_snapshot(ok, 3);
+    CHECK(H != NULL && H->n == 3 && H->min->key == 1);
+    CHECK(fib_heap_find_by_id(H, 1)->parent == H->min);
+    fib_heap_free(H);
+
+    /* truncated: one record short of the header's count, or header only */
+    write_snapshot("FIBSNP2", 3, ok, 2);
+    CHECK(fib_heap_load(SNAP_PATH) == NULL);
+    write_snapshot("FIBSNP2", 3, ok, 0);
+    CHECK(fib_heap_load(SNAP_PATH) == NULL);
+    unsigned char tiny[10] = { 'F', 'I', 'B' };
+    write_file(SNAP_PATH, tiny, sizeof(tiny));
+    CHECK(fib_heap_load(SNAP_PATH) == NULL);
+
+    /* bad magic, including the previous format's */
+    write_snapshot("FIBSNPX", 3, ok, 3);
+    CHECK(fib_heap_load(SNAP_PATH) == NULL);
+    write_snapshot("FIBSNP1", 3, ok, 3);
+    CHECK(fib_heap_load(SNAP_PATH) == NULL);
+
+    /* a child keyed below its parent */
+    int32_t inverted[] = { 5, 0, 1 << 2,   3, 1, 0 };
+    CHECK(load_snapshot(inverted, 2) == NULL);
+
+    /* duplicate and out-of-range ids */
+    int32_t dup[] = { 1, 7, 0,   2, 7, 0 };
+    CHECK(load_snapshot(dup, 2) == NULL);
+    int32_t big[] = { 1, 0, 0,   2, FIB_ID_MAX + 1, 0 };
+    CHECK(load_snapshot(big, 2) == NULL);
+    int32_t huge[] = { 1, INT_MAX, 0 };
+    CHECK(load_snapshot(huge, 1) == NULL);
+
+    /* a degree larger than the records left, or a dead saved min */
+    int32_t deep[] = { 1, 0, 2 << 2,   4, 1, 0 };
+    CHECK(load_snapshot(deep, 2) == NULL);
+    int32_t dead_min[] = { 1, -1, 1 << 1 };
+    CHECK(load_snapshot(dead_min, 1) == NULL);
+
+    /* an empty file and a missing one */
+    write_file(SNAP_PATH, tiny, 0);
+    CHECK(fib_heap_load(SNAP_PATH) == NULL);
+    remove(SNAP_PATH);
+    CHECK(fib_heap_load(SNAP_PATH) == NULL);
+}
+
+int main(void) {
+    test_delete_accounting();
+    test_delete_int_min_key();
+    test_delete_by_id();
+    test_delete_threshold_purge();
+    test_delete_random_mix();
+    test_decrease_key_codes();
+    test_update_key_codes();
+    test_update_key_random();
+    test_peek_k();
+    test_iter();
+    test_meld_empty();
+    test_meld_ids();
+    test_meld_many();
+    test_snapshot_round_trip();
+    test_snapshot_rejects();
+
+    printf("all tests passed\n");
+    return 0;
+}
@@ -0,0 +1,174 @@
+/* ============================
+   GRAPH FILE TESTS
+   ============================
+   Assertion checks for the importers in graph_io.c. Each case writes a
+   small file, loads it and checks the result. Exits non-zero on the first
+   failure.
+
+     gcc -O2 test_graph_io.c graph_io.c graph.c -o test_graph_io
+
+   Usage: ./test_graph_io
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "graph_io.h"
+
+#define CHECK(c)                                                        \
+    do {                                                                \
+        if (!(c)) {                                                     \
+            fprintf(stderr, "%s:%d: check failed: %s\n",                \
+                    __FILE__, __LINE__, #c);                            \
+            exit(1);                                                    \
+        }                                                               \
+    } while (0)
+
+#define TMP_PATH "test_graph_io.tmp"
+
+static Graph* load_text(const char *text, Graph* (*load)(const char*)) {
+    FILE *f = fopen(TMP_PATH, "w");
+    CHECK(f != NULL);
+    fputs(text, f);
+    CHECK(fclose(f) == 0);
+
+    Graph *G = load(TMP_PATH);
+    remove(TMP_PATH);
+    return G;
+}
+
+/* weight of the edge u -> v, or -1 if there is none */
+static int edge_weight(const Graph *G, int u, int v) {
+    for (int e = G->offsets[u]; e < G->offsets[u + 1]; e++)
+        if (G->targets[e] == v)
+            return G->weights[e];
+    return -1;
+}
+
+/* ============================
+   EDGE LIST
+   ============================ */
+static void test_edgelist_weights(void) {
+    Graph *G = load_text("# comment\n"
+                         "0 1 5\n"
+                         "1 2\n"
+                         "\n"
+                         "% comment\n"
+                         "2 0 7 1700000000\n"
+                         "2 3\t\r\n"
+                         "3 1 0", graph_load_edgelist);
+    CHECK(G != NULL);
+    CHECK(G->n == 4 && G->m == 5);
+    CHECK(edge_weight(G, 0, 1) == 5);
+    CHECK(edge_weight(G, 1, 2) == 1);
+    CHECK(edge_weight(G, 2, 0) == 7);
+    CHECK(edge_weight(G, 2, 3) == 1);
+    CHECK(edge_weight(G, 3, 1) == 0);
+    graph_free(G);
+}
+
+static void test_edgelist_rejects(void) {
+    CHECK(load_text("0 1 -3\n", graph_load_edgelist) == NULL);
+    CHECK(load_text("0 1 2\n0 1 -3\n", graph_load_edgelist) == NULL);
+    CHECK(load_text("0 1 x\n", graph_load_edgelist) == NULL);
+    CHECK(load_text("0 1 3x\n", graph_load_edgelist) == NULL);
+    CHECK(load_text("0 1 2.5\n", graph_load_edgelist) == NULL);
+    CHECK(load_text("0 1 99999999999\n", graph_load_edgelist) == NULL);
+    CHECK(load_text("0 -1\n", graph_load_edgelist) == NULL);
+    CHECK(load_text("0x 1\n", graph_load_edgelist) == NULL);
+    CHECK(load_text("0\n", graph_load_edgelist) == NULL);
+
+    /* ids at or past GRAPH_IO_MAX_N are refused before the degree table
+       grows to them */
+    CHECK(load_text("0 1500000000\n", graph_load_edgelist) == NULL);
+    CHECK(load_text("2147483647 0\n", graph_load_edgelist) == NULL);
+}
+
+/* ============================
+   DIMACS
+   ============================ */
+static void test_dimacs(void) {
+    Graph *G = load_text("c tiny\n"
+                         "p sp 3 2\n"
+                         "a 1 2 4\n"
+                         "a 2 3 6\n", graph_load_dimacs);
+    CHECK(G != NULL);
+    CHECK(G->n == 3 && G->m == 2);
+    CHECK(edge_weight(G, 0, 1) == 4 && edge_weight(G, 1, 2) == 6);
+    graph_free(G);
+
+    CHECK(load_text("p sp 3 1\na 1 4 1\n", graph_load_dimacs) == NULL);
+    CHECK(load_text("p sp 3 2\na 1 2 1\n", graph_load_dimacs) == NULL);
+
+    /* every arc field must be a whole non-negative int */
+    CHECK(load_text("p sp 3 1\na 1 2 3x\n", graph_load_dimacs) == NULL);
+    CHECK(load_text("p sp 3 1\na 1 2 -3\n", graph_load_dimacs) == NULL);
+    CHECK(load_text("p sp 3 1\na 1 2 2.5\n", graph_load_dimacs) == NULL);
+    CHECK(load_text("p sp 3 1\na 1x 2 3\n", graph_load_dimacs) == NULL);
+    CHECK(load_text("p sp 3 1\na 1 2\n", graph_load_dimacs) == NULL);
+    CHECK(load_text("p sp 3x 1\na 1 2 3\n", graph_load_dimacs) == NULL);
+
+    /* header sizes are bounded before anything is allocated from them */
+    CHECK(load_text("p sp 2147483647 1\na 1 2 1\n", graph_load_dimacs) == NULL);
+    CHECK(load_text("p sp 3 2147483647\na 1 2 1\n", graph_load_dimacs) == NULL);
+    CHECK(load_text("a 1 2 1\n", graph_load_dimacs) == NULL);
+
+    G = load_text("p sp 2 0\n", graph_load_dimacs);
+    CHECK(G != NULL && G->n == 2 && G->m == 0);
+    graph_free(G);
+}
+
+/* ============================
+   BINARY CSR
+   ============================ */
+
+/* Save G, overwrite one int32 at index i past the header, then map it */
+static Graph* map_patched(const Graph *G, long i, int32_t value) {
+    CHECK(graph_save_binary(G, TMP_PATH) == 0);
+    if (i >= 0) {
+        FILE *f = fopen(TMP_PATH, "r+b");
+        CHECK(f != NULL);
+        CHECK(fseek(f, 32 + i * 4, SEEK_SET) == 0);
+        CHECK(fwrite(&value, sizeof(value), 1, f) == 1);
+        CHECK(fclose(f) == 0);
+    }
+
+    Graph *M = graph_map_binary(TMP_PATH);
+    remove(TMP_PATH);
+    return M;
+}
+
+static void test_binary(void) {
+    int src[] = { 0, 0, 1, 2 };
+    int dst[] = { 1, 2, 2, 0 };
+    int w[]   = { 4, 1, 2, 7 };
+    Graph *G = make_graph(3, 4, src, dst, w);
+    CHECK(G != NULL);
+
+    Graph *M = map_patched(G, -1, 0);
+    CHECK(M != NULL && M->n == 3 && M->m == 4);
+    for (int u = 0; u <= 3; u++)
+        CHECK(M->offsets[u] == G->offsets[u]);
+    for (int e = 0; e < 4; e++)
+        CHECK(M->targets[e] == G->targets[e] && M->weights[e] == G->weights[e]);
+    graph_free(M);
+
+    /* layout after the header: offsets[0..3], targets[4..7], weights[8..11] */
+    CHECK(map_patched(G, 2, 1) == NULL);      /* offsets 0 2 1 4 decrease */
+    CHECK(map_patched(G, 0, 1) == NULL);      /* offsets[0] != 0 */
+    CHECK(map_patched(G, 5, 3) == NULL);      /* target == n */
+    CHECK(map_patched(G, 6, -1) == NULL);     /* negative target */
+    CHECK(map_patched(G, 9, -5) == NULL);     /* negative weight */
+
+    graph_free(G);
+}
+
+int main(void) {
+    test_edgelist_weights();
+    test_edgelist_rejects();
+    test_dimacs();
+    test_binary();
+
+    printf("all tests passed\n");
+    return 0;
+}
@@ -0,0 +1,170 @@
+/* ============================
+   HEAP AGREEMENT TESTS
+   ============================
+   The Fibonacci heap algorithm exists three times: modified_fib_heap.c,
+   the FIBHEAP_DEFINE template in fib_heap_template.h and the index-linked
+   compact_fib_heap.c. This drives one random operation sequence through
+   all three and checks that every result and return code agrees, so the
+   copies cannot drift apart unnoticed. Exits non-zero on the first disagreement.
+
+     gcc -O2 -DFIB_HEAP_NO_MAIN test_heap_agreement.c modified_fib_heap.c \
+         compact_fib_heap.c -lm -o test_heap_agreement
+
+   Usage: ./test_heap_agreement
+*/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "modified_fib_heap.h"
+#include "compact_fib_heap.h"
+#include "fib_heap_template.h"
+
+FIBHEAP_DEFINE(tfib, int, int, FIBHEAP_LT)
+
+#define CHECK(c)                                                        \
+    do {                                                                \
+        if (!(c)) {                                                     \
+            fprintf(stderr, "%s:%d: check failed: %s\n",                \
+                    __FILE__, __LINE__, #c);                            \
+            exit(1);                                                    \
+        }                                                               \
+    } while (0)
+
+/* Keys are value * ITEMS + item, so no two items ever tie and all three
+   heaps must extract exactly the same item at every step. */
+#define ITEMS 32768
+#define VALUE_MAX 60000
+
+static unsigned int rng = 2024;
+
+static int next_rand(void) {
+    rng = rng * 1103515245u + 12345u;
+    return (int)((rng >> 8) & 0x7FFFFF);
+}
+
+typedef struct Mirror {
+    FibHeap *mod;
+    tfib_heap *tpl;
+    CompactFibHeap *cmp;
+
+    FibNode *mod_node[ITEMS];
+    tfib_node *tpl_node[ITEMS];
+    CompactHandle cmp_node[ITEMS];
+    int cmp_item[ITEMS];        /* compact handles are indices */
+
+    int live[ITEMS];            /* items currently in the heaps */
+    int n_live;
+    int n_items;
+} Mirror;
+
+static void check_min(Mirror *M) {
+    CHECK(M->mod->n == M->n_live && M->tpl->n == M->n_live && M->cmp->n == M->n_live);
+    if (M->n_live == 0) {
+        CHECK(fib_heap_min(M->mod) == NULL);
+        CHECK(tfib_min(M->tpl) == NULL);
+        CHECK(compact_fib_heap_min(M->cmp) == COMPACT_NIL);
+        return;
+    }
+
+    int k = fib_heap_min(M->mod)->key;
+    CHECK(tfib_min(M->tpl)->key == k);
+    CHECK(compact_fib_heap_key(M->cmp, compact_fib_heap_min(M->cmp)) == k);
+}
+
+static void op_insert(Mirror *M, int value) {
+    int item = M->n_items++;
+    int key = value * ITEMS + item;
+
+    M->mod_node[item] = fib_heap_insert_with_id(M->mod, key, item);
+    M->tpl_node[item] = tfib_insert(M->tpl, key, item);
+    M->cmp_node[item] = compact_fib_heap_insert(M->cmp, key);
+    CHECK(M->mod_node[item] != NULL && M->cmp_node[item] < ITEMS);
+    M->cmp_item[M->cmp_node[item]] = item;
+    M->live[M->n_live++] = item;
+}
+
+static void op_extract(Mirror *M) {
+    FibNode *a = fib_heap_extract_min(M->mod);
+    tfib_node *b = tfib_extract_min(M->tpl);
+    CompactHandle c = compact_fib_heap_extract_min(M->cmp);
+    CHECK(a != NULL && b != NULL && c != COMPACT_NIL);
+
+    int item = a->id;
+    CHECK(b->payload == item && M->cmp_item[c] == item);
+    CHECK(b->key == a->key && compact_fib_heap_key(M->cmp, c) == a->key);
+
+    for (int i = 0; i < M->n_live; i++) {
+        if (M->live[i] == item) {
+            M->live[i] = M->live[--M->n_live];
+            break;
+        }
+    }
+    fib_heap_release_node(M->mod, a);
+    tfib_release(M->tpl, b);
+    compact_fib_heap_release(M->cmp, c);
+}
+
+/* Lower the item's value by up to drop, keeping its tie-breaking suffix */
+static void op_decrease(Mirror *M, int item, int drop) {
+    int key = M->mod_node[item]->key;
+    int k = (key / ITEMS - drop) * ITEMS + item;
+
+    CHECK(fib_heap_decrease_key(M->mod, M->mod_node[item], k) == 0);
+    CHECK(tfib_decrease_key(M->tpl, M->tpl_node[item], k) == 0);
+    CHECK(compact_fib_heap_decrease_key(M->cmp, M->cmp_node[item], k) == 0);
+    CHECK(compact_fib_heap_key(M->cmp, M->cmp_node[item]) == k);
+}
+
+/* An increase is refused by all three and leaves the key alone */
+static void op_increase(Mirror *M, int item) {
+    int key = M->mod_node[item]->key;
+    int k = key + ITEMS;
+
+    CHECK(fib_heap_decrease_key(M->mod, M->mod_node[item], k) == -1);
+    CHECK(tfib_decrease_key(M->tpl, M->tpl_node[item], k) == -1);
+    CHECK(compact_fib_heap_decrease_key(M->cmp, M->cmp_node[item], k) == -1);
+    CHECK(M->mod_node[item]->key == key && M->tpl_node[item]->key == key);
+    CHECK(compact_fib_heap_key(M->cmp, M->cmp_node[item]) == key);
+}
+
+static void test_agreement(void) {
+    for (int round = 0; round < 5; round++) {
+        Mirror *M = (Mirror*)calloc(1, sizeof(Mirror));
+        M->mod = make_fib_heap();
+        M->tpl = tfib_create();
+        M->cmp = make_compact_fib_heap();
+
+        while (M->n_items < ITEMS) {
+            int op = next_rand() % 100;
+            if (op < 45) {
+                op_insert(M, VALUE_MAX / 2 + next_rand() % (VALUE_MAX / 2));
+            } else if (op < 75 && M->n_live > 0) {
+                op_extract(M);
+            } else if (op < 80 && M->n_live > 0) {
+                op_increase(M, M->live[next_rand() % M->n_live]);
+            } else if (M->n_live > 0) {
+                int item = M->live[next_rand() % M->n_live];
+                int value = M->mod_node[item]->key / ITEMS;
+                op_decrease(M, item, next_rand() % (value / 2 + 1));
+            }
+            check_min(M);
+        }
+
+        while (M->n_live > 0) {
+            op_extract(M);
+            check_min(M);
+        }
+
+        fib_heap_free(M->mod);
+        tfib_free(M->tpl);
+        compact_fib_heap_free(M->cmp);
+        free(M);
+    }
+}
+
+int main(void) {
+    test_agreement();
+
+    printf("all tests passed\n");
+    return 0;
+}
@@ -0,0 +1,801 @@
+/* ============================
+   TRACE REPLAY DRIVER
+   ============================
+   Replays a recorded operation trace against any priority-queue backend,
+   without the interactive menu. The whole trace is loaded first, then
+   replayed twice from a fresh heap. The first run times only the whole
+   loop, for ops/sec. The second times sampled operations one by one, for
+   count, mean and p50/p99/max latency per operation type.
+
+     gcc -O2 -DFIB_HEAP_NO_MAIN trace_replay.c pq_backend.c modified_fib_heap.c \
+         pairing_heap.c dary_heap.c radix_heap.c -lm -o trace_replay
+
+   Direct builds call one pointer heap's own API, with no PQBackend table
+   or adapter in between (-b is then not available):
+
+     gcc -O2 -DFIB_HEAP_NO_MAIN -DTRACE_DIRECT trace_replay.c \
+         modified_fib_heap.c -lm -o trace_replay_fib
+     gcc -O2 -DFIB_HEAP_NO_MAIN -DTRACE_DIRECT_ORIGINAL trace_replay.c \
+         fib_heap.c -lm -o trace_replay_orig
+
+   Usage: ./trace_replay [-b backend] [-p] [-s n] [-B out.bin] [-g n] [trace|-]
+     -b  fib (default), pairing, dary or radix
+     -p  print every min/extract result to stdout (buffered), for diffing
+         the same trace across backends or builds; printed in the first
+         run, so ops/sec then includes the output
+     -s  time every n-th op in the latency run (default 1); 0 skips it
+     -B  also write the loaded trace in binary form to out.bin
+     -g  write a random text trace of n ops to stdout and exit
+   With no file, or "-", the trace is read from stdin in one bulk read.
+
+   Text trace, one operation per line ('#' starts a comment):
+     i <key>         insert into the current heap; items get ids 0, 1, 2, ...
+     m               read the minimum
+     x               extract the minimum
+     d <id> <key>    decrease the key of item <id>
+     e <id>          delete item <id>
+     h <k>           make heap k (0..63) current
+     u <k>           merge heap k into the current heap; k starts over empty
+   Operands must fit an int and only a comment may follow them; any other
+   line stops the load with its line number.
+   Binary trace: the 8 bytes "FIBTRC1\0", then one int32 triple
+   (op, a, b) per operation, op being the index of the letter in "imxdehu".
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <errno.h>
+#include <time.h>
+
+#if defined(TRACE_DIRECT_ORIGINAL)
+#include "fib_heap.h"
+#elif defined(TRACE_DIRECT)
+#include "modified_fib_heap.h"
+#else
+#include "pq_backend.h"
+#endif
+#include "lat_hist.h"
+
+#define TRACE_MAGIC "FIBTRC1"
+#define MAX_HEAPS 64
+#define OUT_BUFFER (1 << 20)
+
+enum { OP_INSERT, OP_MIN, OP_EXTRACT, OP_DECREASE, OP_DELETE, OP_HEAP, OP_UNION, OP_KINDS };
+
+static const char op_letters[] = "imxdehu";
+static const char *op_names[OP_KINDS] = {
+    "insert", "min", "extract", "decrease", "delete", "heap", "union"
+};
+
+typedef struct TraceOp {
+    int32_t op;
+    int32_t a;
+    int32_t b;
+} TraceOp;
+
+typedef struct Trace {
+    TraceOp *ops;
+    int n;
+    int cap;
+} Trace;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* ============================
+   LOADING
+   ============================ */
+static char* read_all(FILE *f, size_t *len) {
+    size_t cap = 1 << 20, n = 0, got;
+    char *buf = (char*)malloc(cap + 1);
+    while ((got = fread(buf + n, 1, cap - n, f)) > 0) {
+        n += got;
+        if (n == cap) {
+            cap *= 2;
+            buf = (char*)realloc(buf, cap + 1);
+        }
+    }
+    buf[n] = '\0';
+    *len = n;
+    return buf;
+}
+
+static void trace_push(Trace *T, int op, int a, int b) {
+    if (T->n == T->cap) {
+        T->cap = T->cap ? T->cap * 2 : 1024;
+        T->ops = (TraceOp*)realloc(T->ops, T->cap * sizeof(TraceOp));
+    }
+    T->ops[T->n].op = op;
+    T->ops[T->n].a = a;
+    T->ops[T->n].b = b;
+    T->n++;
+}
+
+/* Operands each op letter takes */
+static const int op_args[OP_KINDS] = { 1, 0, 0, 2, 1, 1, 1 };
+
+static int parse_text(Trace *T, char *p) {
+    int line = 0;
+    while (*p) {
+        line++;
+        char *end = strchr(p, '\n');
+        if (end)
+            *end = '\0';
+
+        while (*p == ' ' || *p == '\t')
+            p++;
+        if (*p != '\0' && *p != '#' && *p != '\r') {
+            const char *at = strchr(op_letters, *p);
+            if (at == NULL) {
+                fprintf(stderr, "line %d: unknown op '%c'\n", line, *p);
+                return -1;
+            }
+            int op = (int)(at - op_letters);
+            long v[2] = { 0, 0 };
+            char *q = p + 1;
+            for (int k = 0; k < op_args[op]; k++) {
+                char *next;
+                if (*q != ' ' && *q != '\t') {
+                    fprintf(stderr, "line %d: '%c' needs %d operand(s)\n", line, *p, op_args[op]);
+                    return -1;
+                }
+                errno = 0;
+                v[k] = strtol(q, &next, 10);
+                if (next == q) {
+                    fprintf(stderr, "line %d: '%c' needs %d operand(s)\n", line, *p, op_args[op]);
+                    return -1;
+                }
+                if (errno == ERANGE || v[k] < INT_MIN || v[k] > INT_MAX) {
+                    fprintf(stderr, "line %d: operand out of int range\n", line);
+                    return -1;
+                }
+                q = next;
+            }
+
+            /* only blanks or a comment may follow the operands */
+            while (*q == ' ' || *q == '\t' || *q == '\r')
+                q++;
+            if (*q != '\0' && *q != '#') {
+                fprintf(stderr, "line %d: unexpected '%c' after '%c'\n", line, *q, *p);
+                return -1;
+            }
+            trace_push(T, op, (int)v[0], (int)v[1]);
+        }
+
+        if (!end)
+            break;
+        p = end + 1;
+    }
+    return 0;
+}
+
+static int parse_binary(Trace *T, const char *buf, size_t len) {
+    size_t body = len - sizeof(TRACE_MAGIC);
+    if (body % sizeof(TraceOp) != 0)
+        return -1;
+
+    int n = (int)(body / sizeof(TraceOp));
+    T->ops = (TraceOp*)malloc((n > 0 ? n : 1) * sizeof(TraceOp));
+    memcpy(T->ops, buf + sizeof(TRACE_MAGIC), body);
+    T->n = T->cap = n;
+
+    for (int i = 0; i < n; i++) {
+        if (T->ops[i].op < 0 || T->ops[i].op >= OP_KINDS)
+            return -1;
+    }
+    return 0;
+}
+
+static int load_trace(Trace *T, FILE *f) {
+    size_t len;
+    char *buf = read_all(f, &len);
+    int rc;
+
+    if (len >= sizeof(TRACE_MAGIC) && memcmp(buf, TRACE_MAGIC, sizeof(TRACE_MAGIC)) == 0)
+        rc = parse_binary(T, buf, len);
+    else
+        rc = parse_text(T, buf);
+
+    free(buf);
+    return rc;
+}
+
+static int save_binary(const Trace *T, const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return -1;
+    int ok = fwrite(TRACE_MAGIC, sizeof(TRACE_MAGIC), 1, f) == 1
+          && fwrite(T->ops, sizeof(TraceOp), T->n, f) == (size_t)T->n;
+    if (fclose(f) != 0)
+        ok = 0;
+    return ok ? 0 : -1;
+}
+
+/* ============================
+   REPLAY STATE
+   ============================
+   Heap slots can be merged away and reused, so every insert records the
+   incarnation of its slot, and merged incarnations are linked
+   union-find style to the one that absorbed them. */
+#if defined(TRACE_DIRECT_ORIGINAL)
+typedef FibHeap *TraceHeap;
+typedef FibNode *TraceHandle;
+typedef const char *TraceTarget;
+#define TRACE_TARGET_DEFAULT "original (direct)"
+#define TRACE_TARGET_NAME(t) (t)
+
+/* fib_heap.c nodes carry no id, so extracted nodes are mapped back to
+   their item ids through an open-addressing table keyed by address */
+typedef struct NodeIdMap {
+    FibNode **keys;
+    int *ids;
+    size_t cap;     /* power of two, or 0 */
+    size_t n;
+} NodeIdMap;
+#elif defined(TRACE_DIRECT)
+typedef FibHeap *TraceHeap;
+typedef FibNode *TraceHandle;
+typedef const char *TraceTarget;
+#define TRACE_TARGET_DEFAULT "fib (direct)"
+#define TRACE_TARGET_NAME(t) (t)
+#else
+typedef void *TraceHeap;
+typedef PQHandle TraceHandle;
+typedef const PQBackend *TraceTarget;
+#define TRACE_TARGET_DEFAULT (&PQ_BACKEND_DEFAULT)
+#define TRACE_TARGET_NAME(t) ((t)->name)
+#endif
+
+typedef struct Replay {
+#if defined(TRACE_DIRECT_ORIGINAL)
+    NodeIdMap ids;
+#elif !defined(TRACE_DIRECT)
+    const PQBackend *pq;
+#endif
+    TraceHeap heaps[MAX_HEAPS];
+    int slot_inc[MAX_HEAPS];    /* current incarnation of each slot */
+
+    int *inc_parent;            /* union-find over incarnations */
+    int *inc_slot;              /* slot of an incarnation that is still current */
+    int n_inc;
+    int inc_cap;
+
+    TraceHandle *handle;        /* by item id, NULL when not in a heap */
+    int *owner;                 /* incarnation the item was inserted into */
+    int n_items;
+    int items_cap;
+
+    int cur;
+    long long rejected;         /* ops on absent items, refused keys */
+    LatHist lat[OP_KINDS];
+} Replay;
+
+/* ============================
+   HEAP CALLS
+   ============================
+   The only place the replay touches a heap. Each call goes through the
+   PQBackend table, or straight to the pointer heap in a direct build. */
+#if defined(TRACE_DIRECT_ORIGINAL)
+static size_t idmap_home(const NodeIdMap *M, const FibNode *x) {
+    uint64_t h = (uint64_t)(uintptr_t)x * 0x9E3779B97F4A7C15ULL;
+    return (size_t)(h >> 32) & (M->cap - 1);
+}
+
+static void idmap_put(NodeIdMap *M, FibNode *x, int id) {
+    if (2 * (M->n + 1) > M->cap) {
+        NodeIdMap old = *M;
+        M->cap = old.cap ? old.cap * 2 : 1024;
+        M->keys = (FibNode**)calloc(M->cap, sizeof(FibNode*));
+        M->ids = (int*)malloc(M->cap * sizeof(int));
+        M->n = 0;
+        for (size_t i = 0; i < old.cap; i++)
+            if (old.keys[i])
+                idmap_put(M, old.keys[i], old.ids[i]);
+        free(old.keys);
+        free(old.ids);
+    }
+
+    size_t i = idmap_home(M, x);
+    while (M->keys[i])
+        i = (i + 1) & (M->cap - 1);
+    M->keys[i] = x;
+    M->ids[i] = id;
+    M->n++;
+}
+
+/* slot holding x, or cap if x is absent */
+static size_t idmap_find(const NodeIdMap *M, const FibNode *x) {
+    if (M->cap == 0)
+        return 0;
+
+    size_t i = idmap_home(M, x);
+    while (M->keys[i] != x) {
+        if (M->keys[i] == NULL)
+            return M->cap;
+        i = (i + 1) & (M->cap - 1);
+    }
+    return i;
+}
+
+static int idmap_get(const NodeIdMap *M, const FibNode *x) {
+    size_t i = idmap_find(M, x);
+    return i < M->cap ? M->ids[i] : -1;
+}
+
+/* id of x, which is removed from the map; -1 if absent */
+static int idmap_take(NodeIdMap *M, FibNode *x) {
+    size_t mask = M->cap - 1, i = idmap_find(M, x);
+    if (i >= M->cap)
+        return -1;
+    int id = M->ids[i];
+    M->keys[i] = NULL;
+    M->n--;
+
+    /* shift back later entries of the run whose home is not in (i, j] */
+    for (size_t j = (i + 1) & mask; M->keys[j]; j = (j + 1) & mask) {
+        size_t home = idmap_home(M, M->keys[j]);
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            M->keys[i] = M->keys[j];
+            M->ids[i] = M->ids[j];
+            M->keys[j] = NULL;
+            i = j;
+        }
+    }
+    return id;
+}
+
+static TraceHeap heap_create(Replay *R) {
+    (void)R;
+    return make_fib_heap();
+}
+
+static TraceHandle heap_insert(Replay *R, TraceHeap H, int key, int id) {
+    FibNode *x = fib_heap_insert(H, key);
+    idmap_put(&R->ids, x, id);
+    return x;
+}
+
+static int heap_min(Replay *R, TraceHeap H, int *key, int *id) {
+    FibNode *x = fib_heap_min(H);
+    if (x == NULL)
+        return 0;
+    *key = x->key;
+    *id = idmap_get(&R->ids, x);
+    return 1;
+}
+
+static int heap_extract_min(Replay *R, TraceHeap H, int *key, int *id) {
+    FibNode *x = fib_heap_extract_min(H);
+    if (x == NULL)
+        return 0;
+    *key = x->key;
+    *id = idmap_take(&R->ids, x);
+    free(x);
+    return 1;
+}
+
+/* the original prints its own error on an increase, so refuse it here */
+static int heap_decrease_key(Replay *R, TraceHeap H, TraceHandle x, int k) {
+    (void)R;
+    if (k > x->key)
+        return -1;
+    fib_heap_decrease_key(H, x, k);
+    return 0;
+}
+
+/* fib_heap_delete drops the node it extracts, so x is leaked as the
+   original leaks it */
+static void heap_remove(Replay *R, TraceHeap H, TraceHandle x) {
+    idmap_take(&R->ids, x);
+    fib_heap_delete(H, x);
+}
+
+static TraceHeap heap_merge(Replay *R, TraceHeap H1, TraceHeap H2) {
+    (void)R;
+    return fib_heap_union(H1, H2);
+}
+
+static void heap_destroy(Replay *R, TraceHeap H) {
+    (void)R;
+    fib_heap_free(H);
+}
+#elif defined(TRACE_DIRECT)
+static TraceHeap heap_create(Replay *R) {
+    (void)R;
+    return make_fib_heap();
+}
+
+static TraceHandle heap_insert(Replay *R, TraceHeap H, int key, int id) {
+    (void)R;
+    return fib_heap_insert_with_id(H, key, id);
+}
+
+static int heap_min(Replay *R, TraceHeap H, int *key, int *id) {
+    (void)R;
+    FibNode *x = fib_heap_min(H);
+    if (x == NULL)
+        return 0;
+    *key = x->key;
+    *id = x->id;
+    return 1;
+}
+
+static int heap_extract_min(Replay *R, TraceHeap H, int *key, int *id) {
+    (void)R;
+    FibNode *x = fib_heap_extract_min(H);
+    if (x == NULL)
+        return 0;
+    *key = x->key;
+    *id = x->id;
+    fib_heap_release_node(H, x);
+    return 1;
+}
+
+static int heap_decrease_key(Replay *R, TraceHeap H, TraceHandle x, int k) {
+    (void)R;
+    return fib_heap_decrease_key(H, x, k);
+}
+
+static void heap_remove(Replay *R, TraceHeap H, TraceHandle x) {
+    (void)R;
+    fib_heap_delete(H, x);
+}
+
+static TraceHeap heap_merge(Replay *R, TraceHeap H1, TraceHeap H2) {
+    (void)R;
+    return fib_heap_union(H1, H2);
+}
+
+static void heap_destroy(Replay *R, TraceHeap H) {
+    (void)R;
+    fib_heap_free(H);
+}
+#else
+static TraceHeap heap_create(Replay *R) {
+    return R->pq->create();
+}
+
+static TraceHandle heap_insert(Replay *R, TraceHeap H, int key, int id) {
+    return R->pq->insert(H, key, id);
+}
+
+static int heap_min(Replay *R, TraceHeap H, int *key, int *id) {
+    return R->pq->min(H, key, id);
+}
+
+static int heap_extract_min(Replay *R, TraceHeap H, int *key, int *id) {
+    return R->pq->extract_min(H, key, id);
+}
+
+static int heap_decrease_key(Replay *R, TraceHeap H, TraceHandle x, int k) {
+    return R->pq->decrease_key(H, x, k);
+}
+
+static void heap_remove(Replay *R, TraceHeap H, TraceHandle x) {
+    R->pq->remove(H, x);
+}
+
+static TraceHeap heap_merge(Replay *R, TraceHeap H1, TraceHeap H2) {
+    return R->pq->merge(H1, H2);
+}
+
+static void heap_destroy(Replay *R, TraceHeap H) {
+    R->pq->destroy(H);
+}
+#endif
+
+static int new_incarnation(Replay *R, int slot) {
+    if (R->n_inc == R->inc_cap) {
+        R->inc_cap = R->inc_cap ? R->inc_cap * 2 : 256;
+        R->inc_parent = (int*)realloc(R->inc_parent, R->inc_cap * sizeof(int));
+        R->inc_slot = (int*)realloc(R->inc_slot, R->inc_cap * sizeof(int));
+    }
+    int i = R->n_inc++;
+    R->inc_parent[i] = i;
+    R->inc_slot[i] = slot;
+    R->slot_inc[slot] = i;
+    return i;
+}
+
+static int find_inc(Replay *R, int i) {
+    while (R->inc_parent[i] != i) {
+        R->inc_parent[i] = R->inc_parent[R->inc_parent[i]];
+        i = R->inc_parent[i];
+    }
+    return i;
+}
+
+static TraceHeap slot_heap(Replay *R, int slot) {
+    if (R->heaps[slot] == NULL) {
+        R->heaps[slot] = heap_create(R);
+        new_incarnation(R, slot);
+    }
+    return R->heaps[slot];
+}
+
+/* Heap slot holding item id, or -1 if the id is not in any heap */
+static int item_slot(Replay *R, int id) {
+    if (id < 0 || id >= R->n_items || R->handle[id] == NULL)
+        return -1;
+    return R->inc_slot[find_inc(R, R->owner[id])];
+}
+
+/* ============================
+   REPLAY
+   ============================ */
+static void replay_op(Replay *R, const TraceOp *o, FILE *out) {
+    int key, id, s;
+    TraceHeap merged;
+
+    switch (o->op) {
+    case OP_INSERT:
+        if (R->n_items == R->items_cap) {
+            R->items_cap = R->items_cap ? R->items_cap * 2 : 1024;
+            R->handle = (TraceHandle*)realloc(R->handle, R->items_cap * sizeof(TraceHandle));
+            R->owner = (int*)realloc(R->owner, R->items_cap * sizeof(int));
+        }
+        id = R->n_items++;
+        R->handle[id] = heap_insert(R, slot_heap(R, R->cur), o->a, id);
+        R->owner[id] = R->slot_inc[R->cur];
+        if (R->handle[id] == NULL)
+            R->rejected++;
+        break;
+
+    case OP_MIN:
+        if (heap_min(R, slot_heap(R, R->cur), &key, &id)) {
+            if (out) fprintf(out, "m %d %d\n", key, id);
+        } else if (out) {
+            fprintf(out, "m empty\n");
+        }
+        break;
+
+    case OP_EXTRACT:
+        if (heap_extract_min(R, slot_heap(R, R->cur), &key, &id)) {
+            R->handle[id] = NULL;
+            if (out) fprintf(out, "x %d %d\n", key, id);
+        } else if (out) {
+            fprintf(out, "x empty\n");
+        }
+        break;
+
+    case OP_DECREASE:
+        s = item_slot(R, o->a);
+        if (s < 0 || heap_decrease_key(R, R->heaps[s], R->handle[o->a], o->b) != 0)
+            R->rejected++;
+        break;
+
+    case OP_DELETE:
+        s = item_slot(R, o->a);
+        if (s < 0) {
+            R->rejected++;
+            break;
+        }
+        heap_remove(R, R->heaps[s], R->handle[o->a]);
+        R->handle[o->a] = NULL;
+        break;
+
+    case OP_HEAP:
+        if (o->a < 0 || o->a >= MAX_HEAPS) {
+            R->rejected++;
+            break;
+        }
+        R->cur = o->a;
+        slot_heap(R, R->cur);
+        break;
+
+    case OP_UNION:
+        if (o->a < 0 || o->a >= MAX_HEAPS || o->a == R->cur) {
+            R->rejected++;
+            break;
+        }
+        s = o->a;
+        slot_heap(R, s);
+        merged = heap_merge(R, slot_heap(R, R->cur), R->heaps[s]);
+        if (merged == NULL) {
+            R->rejected++;
+            break;
+        }
+        R->heaps[R->cur] = merged;
+        R->inc_parent[R->slot_inc[s]] = R->slot_inc[R->cur];
+        R->heaps[s] = NULL;
+        break;
+    }
+}
+
+static void replay_init(Replay *R, TraceTarget target) {
+    memset(R, 0, sizeof(*R));
+#if defined(TRACE_DIRECT) || defined(TRACE_DIRECT_ORIGINAL)
+    (void)target;
+#else
+    R->pq = target;
+#endif
+    for (int k = 0; k < OP_KINDS; k++)
+        lat_hist_reset(&R->lat[k]);
+    slot_heap(R, 0);
+}
+
+static void replay_free(Replay *R) {
+    for (int k = 0; k < MAX_HEAPS; k++) {
+        if (R->heaps[k])
+            heap_destroy(R, R->heaps[k]);
+    }
+#if defined(TRACE_DIRECT_ORIGINAL)
+    free(R->ids.keys);
+    free(R->ids.ids);
+#endif
+    free(R->handle);
+    free(R->owner);
+    free(R->inc_parent);
+    free(R->inc_slot);
+}
+
+/* Throughput run: only the loop as a whole is timed */
+static double replay_throughput(Replay *R, const Trace *T, FILE *out) {
+    double t0 = now_ns();
+    for (int i = 0; i < T->n; i++)
+        replay_op(R, &T->ops[i], out);
+    return now_ns() - t0;
+}
+
+/* Latency run: every op runs, every every-th one is timed alone */
+static void replay_latency(Replay *R, const Trace *T, int every) {
+    for (int i = 0; i < T->n; i++) {
+        if (i % every != 0) {
+            replay_op(R, &T->ops[i], NULL);
+            continue;
+        }
+        double a = now_ns();
+        replay_op(R, &T->ops[i], NULL);
+        lat_hist_record(&R->lat[T->ops[i].op], (unsigned long long)(now_ns() - a));
+    }
+}
+
+/* Smallest gap between two back-to-back clock reads */
+static double timer_overhead_ns(void) {
+    double best = 1e9;
+    for (int i = 0; i < 1000; i++) {
+        double a = now_ns();
+        double d = now_ns() - a;
+        if (d < best)
+            best = d;
+    }
+    return best;
+}
+
+static void report(const Replay *L, int every, const Replay *R, int n, double total_ns) {
+    if (every > 0) {
+        printf("%-10s %12s %10s %10s %10s %10s\n", "op", "sampled", "mean ns", "p50", "p99", "max");
+        for (int k = 0; k < OP_KINDS; k++) {
+            const LatHist *h = &L->lat[k];
+            if (h->count == 0)
+                continue;
+            printf("%-10s %12llu %10.1f %10llu %10llu %10llu\n", op_names[k], h->count,
+                   (double)h->total / h->count, lat_hist_percentile(h, 50.0),
+                   lat_hist_percentile(h, 99.0), h->max);
+        }
+        printf("(1 in %d ops timed, each with about %.0f ns of timer overhead)\n",
+               every, timer_overhead_ns());
+    }
+    printf("\n%d ops in %.1f ms: %.0f ops/sec (%lld rejected)\n",
+           n, total_ns / 1e6, n / (total_ns / 1e9), R->rejected);
+}
+
+/* ============================
+   RANDOM TRACE GENERATOR
+   ============================ */
+static void generate(long long n) {
+    unsigned long long s = 88172645463325252ULL;
+    long long items = 0;
+
+    for (long long i = 0; i < n; i++) {
+        s ^= s << 13;
+        s ^= s >> 7;
+        s ^= s << 17;
+        unsigned int r = (unsigned int)(s >> 33);
+        int kind = r % 100;
+
+        if (kind < 45 || items == 0) {
+            printf("i %u\n", r % 1000000u);
+            items++;
+        } else if (kind < 75) {
+            printf("x\n");
+        } else if (kind < 90) {
+            printf("d %lld %u\n", (long long)(r % items), (r >> 8) % 1000u);
+        } else if (kind < 95) {
+            printf("m\n");
+        } else if (kind < 99 || (r >> 8) % 16 != 0) {
+            printf("e %lld\n", (long long)(r % items));
+        } else {
+            /* rare: switch heap and absorb another one */
+            printf("h %u\nu %u\n", (r >> 4) % 4, (r >> 12) % 4);
+        }
+    }
+}
+
+/* ============================
+   MAIN
+   ============================ */
+int main(int argc, char **argv) {
+    TraceTarget target = TRACE_TARGET_DEFAULT;
+    const char *path = NULL, *bin_out = NULL;
+    int print = 0, every = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+#if defined(TRACE_DIRECT) || defined(TRACE_DIRECT_ORIGINAL)
+            fprintf(stderr, "-b needs the PQBackend build\n");
+            return 1;
+#else
+            target = pq_backend_by_name(argv[++i]);
+            if (!target) {
+                fprintf(stderr, "unknown backend: %s\n", argv[i]);
+                return 1;
+            }
+#endif
+        } else if (strcmp(argv[i], "-p") == 0) {
+            print = 1;
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            every = atoi(argv[++i]);
+            if (every < 0) {
+                fprintf(stderr, "-s needs n >= 0\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-B") == 0 && i + 1 < argc) {
+            bin_out = argv[++i];
+        } else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+            setvbuf(stdout, NULL, _IOFBF, OUT_BUFFER);
+            generate(atoll(argv[++i]));
+            return 0;
+        } else {
+            path = argv[i];
+        }
+    }
+
+    FILE *in = stdin;
+    if (path && strcmp(path, "-") != 0) {
+        in = fopen(path, "rb");
+        if (!in) {
+            fprintf(stderr, "cannot open %s\n", path);
+            return 1;
+        }
+    }
+
+    Trace T = { NULL, 0, 0 };
+    if (load_trace(&T, in) != 0) {
+        fprintf(stderr, "malformed trace\n");
+        free(T.ops);
+        return 1;
+    }
+    if (in != stdin)
+        fclose(in);
+    if (bin_out && save_binary(&T, bin_out) != 0) {
+        fprintf(stderr, "cannot write %s\n", bin_out);
+        return 1;
+    }
+
+    setvbuf(stdout, NULL, _IOFBF, OUT_BUFFER);
+
+    Replay R, L;
+    replay_init(&R, target);
+    double total = replay_throughput(&R, &T, print ? stdout : NULL);
+    if (every > 0) {
+        replay_init(&L, target);
+        replay_latency(&L, &T, every);
+    }
+
+    if (print)
+        printf("\n");
+    printf("backend: %s\n", TRACE_TARGET_NAME(target));
+    report(&L, every, &R, T.n, total);
+
+    replay_free(&R);
+    if (every > 0)
+        replay_free(&L);
+    free(T.ops);
+    return 0;
+}